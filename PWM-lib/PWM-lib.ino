@@ -23,8 +23,15 @@
 // #define OFFSET_TEST
 // #define MODE_TEST
 // #define ADV_MODE_TEST
+// #define MEASURE_TEST // Needs the PWM pins wired to pin 8 (ICP1)
+// #define CYCLE_TEST   // Prints the CPU cycles of the interrupt work
 
 #include "PWM.h"
+#include "PWM_measure.h"
+#include "PWM_dither.h"
+#include "PWM_control.h"
+#include "PWM_svpwm.h"
+#include "PWM_hooks.h"
 
 PWM_SIG _pwm[NUM_PWM];
 
@@ -32,7 +39,7 @@ void initialize_signals(void);
 
 void handle_error(PWM_LOG error);
 void print_PWM_testID(uint8_t ID);
-void print_testResults(uint16_t numPassed, uint16_t numTests, String testString);
+void print_testResults(uint16_t numPassed, uint16_t numTests, const char *testString);
 
 uint8_t freq_test(void);
 uint8_t dutyCycle_test(void);
@@ -40,6 +47,8 @@ uint8_t output_test(void);
 uint8_t offset_test(void);
 uint8_t mode_test(void);
 uint8_t advMode_test(void);
+uint8_t measure_test(void);
+void cycle_test(void);
 
 void setup(){
     uint16_t numPassed = 0;
@@ -78,6 +87,15 @@ void setup(){
         numTests++;
     #endif
 
+    #ifdef MEASURE_TEST
+        numPassed += measure_test();
+        numTests++;
+    #endif
+
+    #ifdef CYCLE_TEST
+        cycle_test();
+    #endif
+
     print_testResults(numPassed, NUM_PWM*numTests, "FINAL RESULTS");
 }
 
@@ -111,6 +129,21 @@ void handle_error(PWM_LOG error){
         case INVALID_PWM_DUTY_CYCLE_VALUE:
             Serial.print("Duty Cycle Value Is Over 100\%");
             break;
+        case PWM_MEASURE_TIMEOUT:
+            Serial.print("No Signal Measured!");
+            break;
+        case PWM_MEASURE_OVERRUN:
+            Serial.print("Signal Too Fast To Measure!");
+            break;
+        case INVALID_PWM_PULSE_WIDTH:
+            Serial.print("Pulse Width Out Of Range!");
+            break;
+        case PWM_PULSE_BUSY:
+            Serial.print("Last Pulse Still Running!");
+            break;
+        case INVALID_PWM_FRAME:
+            Serial.print("Bad Frame!");
+            break;
         default:
             Serial.print("UNKNOWN ERROR!");
     }
@@ -123,8 +156,8 @@ void print_PWM_testID(uint8_t ID){
     Serial.print("]...");
 }
 
-void print_testResults(uint16_t numPassed, uint16_t numTests, String testString){
-    Serial.print(testString.c_str());
+void print_testResults(uint16_t numPassed, uint16_t numTests, const char *testString){
+    Serial.print(testString);
     Serial.print(": ");
     Serial.print(numPassed);
     Serial.print("/");
@@ -148,6 +181,7 @@ uint8_t freq_test(void){
         }
     }
     print_testResults(numPassed, NUM_PWM, "RESULTS");
+    return numPassed;
 }
 #endif
 
@@ -253,4 +287,134 @@ uint8_t advMode_test(void){
     print_testResults(numPassed, NUM_PWM, "RESULTS");
     return numPassed;
 }
-#endif
\ No newline at end of file
+#endif
+#ifdef MEASURE_TEST
+uint8_t measure_test(void){
+    uint8_t numPassed = 0;
+    PWM_MEASUREMENT result = {0, 0, 0, 0};
+    Serial.print("Starting Measurement Test:\n");
+    for(uint8_t i = 0; i < NUM_PWM; i++){
+        print_PWM_testID(i);
+
+        // The capture ISR can't keep up with fast PWM at 31 kHz (62.5 kHz
+        // on Timer2), so the pin is measured in phase correct at 490 Hz
+        PWM_SIG sig = _pwm[i];
+        sig.mode = PWM_PHASE_CORR;
+        sig.frequency = _490_2Hz;
+
+        // Put the signal on the pin before checking it
+        setMode(sig.pin, sig.mode);
+        setFreq(sig.pin, sig.frequency);
+        setDutyCycle(sig.pin, sig.dutyCycle);
+        setOutputType(sig.pin, sig.output);
+
+        PWM_LOG log = PWM_verify(&sig, &result);
+        Serial.print(result.frequency / 100);
+        Serial.print(" Hz, ");
+        Serial.print(result.dutyCycle / 100);
+        Serial.print("% ...");
+        if(log != NO_PWM_ERROR){
+            handle_error(log);
+        } else {
+            Serial.print("Passed!\n");
+            numPassed++;
+        }
+    }
+    print_testResults(numPassed, NUM_PWM, "RESULTS");
+    return numPassed;
+}
+#endif
+#ifdef CYCLE_TEST
+// Timer1 counts every CPU cycle while the code runs, with interrupts
+// off. The cycles taken by reading TCNT1 are taken off the result.
+#define TIME_CYCLES(cycles, code) do { \
+        uint8_t oldSREG = SREG; \
+        cli(); \
+        uint8_t oldTCCR1A = TCCR1A; \
+        uint8_t oldTCCR1B = TCCR1B; \
+        TCCR1A = 0; \
+        TCCR1B = _BV(CS10); \
+        uint16_t start = TCNT1; \
+        code; \
+        cycles = TCNT1 - start; \
+        TCCR1A = oldTCCR1A; \
+        TCCR1B = oldTCCR1B; \
+        SREG = oldSREG; \
+    } while(0)
+
+// The same work as a hook and as a bare ISR(), to see what a hook adds
+static volatile uint8_t isrCount = 0;
+
+ISR(TIMER1_COMPA_vect){
+    isrCount++;
+}
+
+PWM_ON_COMPARE(_10, pwm){
+    (void)pwm;
+    isrCount++;
+}
+
+static void print_cycles(const char *name, uint16_t cycles, uint16_t overhead){
+    Serial.print("\t");
+    Serial.print(name);
+    Serial.print(": ");
+    Serial.print(cycles - overhead);
+    Serial.print(" cycles\n");
+}
+
+void cycle_test(void){
+    uint16_t overhead, cycles;
+    Serial.print("Starting Cycle Test:\n");
+    TIME_CYCLES(overhead, );
+
+    // The body of the Timer2 overflow ISR with 0, 1 and 2 pins dithered,
+    // each pin adds the difference
+    TIME_CYCLES(cycles, PWM_ditherTimer2());
+    print_cycles("Dither, no pins", cycles, overhead);
+    setDitheredDuty(_3, 0x8040);
+    TIME_CYCLES(cycles, PWM_ditherTimer2());
+    print_cycles("Dither, pin 3", cycles, overhead);
+    setDitheredDuty(_11, 0x8040);
+    TIME_CYCLES(cycles, PWM_ditherTimer2());
+    print_cycles("Dither, pins 3 and 11", cycles, overhead);
+    stopDither(_3);
+    stopDither(_11);
+
+    // One step of the control loop with 1 to PWM_CONTROL_MAX channels
+    static const PWM_PIN outPins[] = { _9, _10, _3, _11, _5, _6 };
+    static const uint8_t tachPins[] = { 2, 4, 7, 8, 12, 14 };
+    static PWM_CONTROL ctrl[PWM_CONTROL_MAX];
+    for(uint8_t i = 0; (i < PWM_CONTROL_MAX) && (i < 6); i++){
+        ctrl[i].pin = outPins[i];
+        ctrl[i].tachPin = tachPins[i];
+        ctrl[i].kp = 5 * 256;
+        ctrl[i].ki = 384;
+        ctrl[i].kd = 0;
+        ctrl[i].outMax = 255;
+        ctrl[i].setpoint = 6 * 256;
+        PWM_controlAdd(&ctrl[i]);
+        TIME_CYCLES(cycles, PWM_controlRun());
+        char label[] = "Control loop, 0 channels";
+        label[14] = '1' + i;
+        print_cycles(label, cycles, overhead);
+    }
+
+    // Both ISRs are called like a function and end with reti, which
+    // turns interrupts on. Nothing else may be pending then, so the
+    // serial port is emptied and millis() is held off.
+    uint16_t bare, hook;
+    Serial.flush();
+    uint8_t oldTIMSK0 = TIMSK0;
+    TIMSK0 = 0;
+    TIME_CYCLES(bare, TIMER1_COMPA_vect());
+    TIME_CYCLES(hook, TIMER1_COMPB_vect());
+    TIMSK0 = oldTIMSK0;
+    print_cycles("Bare ISR()", bare, overhead);
+    print_cycles("PWM_ON_COMPARE() hook", hook, overhead);
+
+    // Working out the next space vector update, the timers aren't touched
+    PWM_svpwmSet(0x1234, PWM_SVPWM_MAX);
+    TIME_CYCLES(cycles, PWM_svpwmRun());
+    print_cycles("Space vector update", cycles, overhead);
+}
+#endif
@@ -177,7 +177,12 @@ typedef enum PWM_LOG {
     UNDEFINED_PWM_VALUE,
     INVALID_PWM_FREQ,
     INVALID_PWM_PIN,
-    INVALID_PWM_DUTY_CYCLE_VALUE
+    INVALID_PWM_DUTY_CYCLE_VALUE,
+    PWM_MEASURE_TIMEOUT,
+    PWM_MEASURE_OVERRUN,
+    INVALID_PWM_PULSE_WIDTH,
+    PWM_PULSE_BUSY,
+    INVALID_PWM_FRAME
 } PWM_LOG;
 
 /**
@@ -198,15 +203,60 @@ typedef struct {
     uint8_t offset;
 } PWM_SIG;
 
+// Index of every pin in PWM_signals
+#define PWM_CHANNEL__3  0
+#define PWM_CHANNEL__5  1
+#define PWM_CHANNEL__6  2
+#define PWM_CHANNEL__9  3
+#define PWM_CHANNEL__10 4
+#define PWM_CHANNEL__11 5
+
+/** @brief The PWM_SIG last given to PWM_init() for every pin, NULL if there wasn't one */
+extern PWM_SIG *PWM_signals[6];
+
+// Bits set in PWM_sharedIrq while a hook from PWM_hooks.h also needs a
+// timer interrupt, so a library module that stops leaves it on
+#define PWM_SHARED_TIMER0_COMPA 0
+#define PWM_SHARED_TIMER2_OVF   1
+#define PWM_SHARED_TIMER1_OVF   2
+
+extern volatile uint8_t PWM_sharedIrq;
+
 /** 
  * @brief   Initializes PWM signal based on settings set in a PWM_SIG
  * 
+ * @details The PWM_SIG is also remembered in PWM_signals, so it has to
+ *          stay around for as long as the pin is used. From then on
+ *          setFreq(), setMode(), setAdvancedMode(), setOutputType() and
+ *          setDutyCycle() keep it up to date when they succeed.
+ * 
  * @param   pwm     A PWM_SIG pointer type containing all PWM settings
  * 
  * @warning This function is still in development
  */
 void PWM_init(PWM_SIG *pwm);
 
+/**
+ * @brief   Gives the PWM_SIG that was last given to PWM_init() for a pin
+ * 
+ * @param   pin     PWM_PIN type.
+ * 
+ * @return  The PWM_SIG pointer, or NULL if there isn't one for that pin
+ */
+PWM_SIG *PWM_getSignal(PWM_PIN pin);
+
+/**
+ * @brief   Gives the PWM_SIG of the other pin on the same timer
+ * 
+ * @details Both pins of a timer share its frequency and mode, so the
+ *          setters update the PWM_SIG of both pins when those change.
+ * 
+ * @param   pin     PWM_PIN type.
+ * 
+ * @return  The PWM_SIG pointer, or NULL if there isn't one for that pin
+ */
+PWM_SIG *PWM_getSiblingSignal(PWM_PIN pin);
+
 /**
  * @brief   Sets the frequency of a PWM signal
  * 
@@ -218,8 +268,8 @@ void PWM_init(PWM_SIG *pwm);
  * 
  * @warning Not all PWM pins can support the frequencies given in PWM_FREQUENCY.
  *          To see what pins can produce what frequencies, see the board's
- *          documentaion. There is no guarentee that this function will return
- *          any errors if a pin doesn't support that frequency.
+ *          documentaion. If a pin doesn't support that frequency,
+ *          INVALID_PWM_FREQ is returned and the timer is left as it was.
  * 
  * @warning Not all pins can be set to different frequencies. This depends on
  *          what timer each pin is connected to. See your board's documentaion
@@ -227,6 +277,22 @@ void PWM_init(PWM_SIG *pwm);
  */
 PWM_LOG setFreq(PWM_PIN pin, PWM_FREQUENCY freq);
 
+/**
+ * @brief   Checks if a pin's timer can make a frequency, without
+ *          changing anything
+ * 
+ * @details setFreq() does the same check before it touches the timer,
+ *          so a frequency the pin can't make leaves the timer running.
+ * 
+ * @param   pin     PWM_PIN type.
+ * 
+ * @param   freq    PWM_FREQUENCY type.
+ * 
+ * @return  INVALID_PWM_PIN, INVALID_PWM_FREQ if the pin's timer can't
+ *          make that frequency, otherwise NO_PWM_ERROR.
+ */
+PWM_LOG checkFreq(PWM_PIN pin, PWM_FREQUENCY freq);
+
 /**
  * @brief   Similar to setFreq(), but can take in an unspecified number
  * 
@@ -298,6 +364,21 @@ void setAdvancedMode(PWM_PIN pin, PWM_MODE mode, PWM_ADV_MODE setting);
  */
 PWM_LOG setDutyCycle(PWM_PIN pin, uint16_t percent); // it says duty :D
 
+/**
+ * @brief   Sets the compare value (OCR) of a PWM directly
+ * 
+ * @details Unlike setDutyCycle(), this uses the full resolution of the
+ *          timer. The value isn't checked against TOP.
+ * 
+ * @param   pin     PWM_PIN type. This type is used to help debug and 
+ *                  ensure the programmer is using the correct pin for 
+ *                  the specfied board.
+ * 
+ * @param   value   uint16_t type. Only the lower 8 bits are used on 
+ *                  pins with an 8-bit timer.
+ */
+PWM_LOG setCompareValue(PWM_PIN pin, uint16_t value);
+
 /**
  * @brief   Sets desired output type of PWM
  * 
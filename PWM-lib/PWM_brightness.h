@@ -0,0 +1,175 @@
+/**
+ * @file    PWM_brightness.h
+ * @date    Oct 19 2026
+ * @author  Amulek1416
+ *
+ * @brief   Perceptual brightness for LEDs using lookup tables that
+ *          are worked out by the compiler and stored in PROGMEM.
+ *
+ * @details The eye doesn't see brightness linearly, so equal steps
+ *          in duty cycle look much bigger at the low end. The curves
+ *          in here are constexpr functions, so the compiler fills in
+ *          every table and there is no floating point in the program.
+ *          setBrightness() is a single table read for the resolution
+ *          of the pin.
+ *
+ *          Which curve the built in tables use can be picked with
+ *          PWM_BRIGHTNESS_CURVE. A custom curve is any constexpr
+ *          function taking (level, top) and returning the OCR value:
+ *
+ * @code
+ *  constexpr uint16_t myCurve(uint16_t level, uint16_t top){
+ *      return PWM_gammaPow(level, top, 2.8f);
+ *  }
+ *  PWM_BRIGHTNESS_TABLE(uint8_t, myTable, myCurve, 0xFF);
+ *  // ...
+ *  OCR2A = pgm_read_byte(&myTable[level]);
+ * @endcode
+ *
+ * @warning With PWM_FAST, an OCR of 0 still gives a pulse one tick
+ *          long. Use setOutputType() with PWM_DISABLE to turn an LED
+ *          completely off.
+ */
+
+#ifndef PWM_BRIGHTNESS_H
+#define PWM_BRIGHTNESS_H
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+#include "PWM.h"
+
+/** @brief Curve used by the built in tables (PWM_cieCurve or PWM_gammaCurve) */
+#ifndef PWM_BRIGHTNESS_CURVE
+    #define PWM_BRIGHTNESS_CURVE PWM_cieCurve
+#endif
+
+/** @brief Exponent used by PWM_gammaCurve() */
+#ifndef PWM_GAMMA
+    #define PWM_GAMMA 2.2f
+#endif
+
+/** @brief ICR1 value the 16-bit table is made for */
+#ifndef PWM_BRIGHTNESS_TOP
+    #define PWM_BRIGHTNESS_TOP 0xFFFF
+#endif
+
+/** @brief Highest brightness level, the tables have one more entry than this */
+#define PWM_BRIGHTNESS_MAX 255
+
+// Helpers for the curves. They are only written this way (one return
+// and recursion instead of loops) to be constexpr in C++11.
+
+constexpr float pwmSquare(float x){ return x * x; }
+
+constexpr float pwmCube(float x){ return x * x * x; }
+
+constexpr float pwmLnSeries(float z2, float term, int k){
+    return (k > 20) ? 0.0f : (term / (2 * k + 1)) + pwmLnSeries(z2, term * z2, k + 1);
+}
+
+// Doubles x until it is at least 0.5 so the series converges quickly
+constexpr float pwmLn(float x, int halves = 0){
+    return (x < 0.5f) ?
+        pwmLn(x * 2.0f, halves + 1) :
+        2.0f * pwmLnSeries(pwmSquare((x - 1.0f) / (x + 1.0f)), (x - 1.0f) / (x + 1.0f), 0)
+            - (halves * 0.69314718f);
+}
+
+constexpr float pwmExpSeries(float y, float term, int k){
+    return (k > 10) ? 0.0f : term + pwmExpSeries(y, term * y / (k + 1), k + 1);
+}
+
+// Halves y until it is small, then squares the result back up
+constexpr float pwmExp(float y){
+    return (y < -0.0625f) ? pwmSquare(pwmExp(y * 0.5f)) : pwmExpSeries(y, 1.0f, 0);
+}
+
+/**
+ * @brief   Power curve, top * (level / PWM_BRIGHTNESS_MAX) ^ gamma
+ *
+ * @param   level   Brightness level, 0 - PWM_BRIGHTNESS_MAX
+ *
+ * @param   top     OCR value for full brightness
+ *
+ * @param   gamma   Exponent of the curve
+ */
+constexpr uint16_t PWM_gammaPow(uint16_t level, uint16_t top, float gamma){
+    return (level == 0) ? 0 :
+           (level >= PWM_BRIGHTNESS_MAX) ? top :
+           (uint16_t)(pwmExp(gamma * pwmLn((float)level / PWM_BRIGHTNESS_MAX)) * top + 0.5f);
+}
+
+/** @brief PWM_gammaPow() using PWM_GAMMA */
+constexpr uint16_t PWM_gammaCurve(uint16_t level, uint16_t top){
+    return PWM_gammaPow(level, top, PWM_GAMMA);
+}
+
+/**
+ * @brief   CIE 1931 lightness curve
+ *
+ * @details The level is used as L* (scaled to 0 - 100) and the
+ *          luminance Y it needs is returned scaled to top.
+ */
+constexpr uint16_t PWM_cieCurve(uint16_t level, uint16_t top){
+    return (uint16_t)(
+        ((level * 100.0f / PWM_BRIGHTNESS_MAX) > 8.0f ?
+            pwmCube(((level * 100.0f / PWM_BRIGHTNESS_MAX) + 16.0f) / 116.0f) :
+            (level * 100.0f / PWM_BRIGHTNESS_MAX) / 903.3f)
+        * top + 0.5f);
+}
+
+// Repeats a curve for every level so the whole table is a constant
+// initializer. Nothing here is run on the board.
+#define PWM_B1(c, t, n)     c((n), (t))
+#define PWM_B4(c, t, n)     PWM_B1(c, t, n), PWM_B1(c, t, n + 1), PWM_B1(c, t, n + 2), PWM_B1(c, t, n + 3)
+#define PWM_B16(c, t, n)    PWM_B4(c, t, n), PWM_B4(c, t, n + 4), PWM_B4(c, t, n + 8), PWM_B4(c, t, n + 12)
+#define PWM_B64(c, t, n)    PWM_B16(c, t, n), PWM_B16(c, t, n + 16), PWM_B16(c, t, n + 32), PWM_B16(c, t, n + 48)
+#define PWM_B256(c, t, n)   PWM_B64(c, t, n), PWM_B64(c, t, n + 64), PWM_B64(c, t, n + 128), PWM_B64(c, t, n + 192)
+
+/**
+ * @brief   Makes a brightness table in PROGMEM
+ *
+ * @param   type    uint8_t or uint16_t, whatever fits top
+ *
+ * @param   name    Name of the table
+ *
+ * @param   curve   constexpr function taking (level, top)
+ *
+ * @param   top     OCR value for full brightness
+ */
+#define PWM_BRIGHTNESS_TABLE(type, name, curve, top) \
+    extern const type name[PWM_BRIGHTNESS_MAX + 1] PROGMEM = { PWM_B256(curve, top, 0) }
+
+// setBrightness() uses all three built in tables, 1280 bytes of flash
+
+/** @brief Built in table for the 8-bit timers and the 8-bit Timer1 modes */
+extern const uint8_t PWM_brightness8[PWM_BRIGHTNESS_MAX + 1];
+
+/** @brief Built in table for the 9-bit and 10-bit Timer1 modes */
+extern const uint16_t PWM_brightness10[PWM_BRIGHTNESS_MAX + 1];
+
+/** @brief Built in table for Timer1 with ICR1 or OCR1A as TOP */
+extern const uint16_t PWM_brightness16[PWM_BRIGHTNESS_MAX + 1];
+
+/**
+ * @brief   Sets the perceived brightness of an LED on a PWM pin
+ *
+ * @details The table used depends on the resolution of the pin.
+ *          Pins 9 and 10 check the Timer1 mode to pick between the
+ *          8-bit, 10-bit (9-bit is shifted down by one) or 16-bit
+ *          tables. For the 16-bit modes, PWM_BRIGHTNESS_TOP has to
+ *          be the same as the TOP used by the timer.
+ *
+ * @param   pin     PWM_PIN type. This type is used to help debug and
+ *                  ensure the programmer is using the correct pin for
+ *                  the specfied board.
+ *
+ * @param   level   uint8_t type. Perceived brightness, 0 - 255.
+ *
+ * @return  INVALID_PWM_PIN, UNDEFINED_PWM_VALUE for pin 9 when OCR1A
+ *          is the TOP of Timer1 (WGM 4, 9, 11 and 15), otherwise
+ *          NO_PWM_ERROR.
+ */
+PWM_LOG setBrightness(PWM_PIN pin, uint8_t level);
+
+#endif /*PWM_BRIGHTNESS_H*/
@@ -0,0 +1,149 @@
+/**
+ * @file    PWM_control.h
+ * @date    Oct 19 2026
+ * @author  Amulek1416
+ *
+ * @brief   Closed-loop speed control of fans and pumps from their
+ *          tachometer signal.
+ *
+ * @details Tach edges are counted with pin change interrupts, so any
+ *          digital pin can be used. The loop runs from the Timer1
+ *          overflow interrupt once every few overflows and uses a
+ *          fixed-point PID (no floating point) with anti-windup. The
+ *          output is written straight to OCR, so it has the full
+ *          resolution of the timer instead of 1% steps.
+ *
+ *          Units used by every channel:
+ *          - setpoint and measured: tach edges per loop, Q8.8
+ *          - kp, ki and kd: OCR counts per edge per loop, Q8.8
+ *          - outMax: OCR value for full output (TOP of the timer)
+ *
+ *          Tach edges are counted once every loop, so at low speed
+ *          the measured value jumps between whole edges. The integral
+ *          averages this out, but a slower loop (bigger divider) gives
+ *          a smoother measurement.
+ *
+ *          tools/host/control_step.cpp runs the loop on a PC against
+ *          a fan with a lag of 8 loops. With kp = 5 and ki = 1.5 counts
+ *          per edge it settles within 5% in 41 loops, with under 1%
+ *          overshoot. That only checks the control, the PC says nothing
+ *          about the cost on an AVR. Only CYCLE_TEST in PWM-lib.ino
+ *          gives real numbers, the cycles one loop takes on a board for
+ *          1 to PWM_CONTROL_MAX channels.
+ *
+ * @warning Timer1 has to be running for the loop to run. The loop can't
+ *          run at the same time as PWM_svpwmBegin(), which runs Timer1
+ *          at clk/1 and stops the loop when it starts.
+ *
+ * @warning The library has the PCINT0, PCINT1 and PCINT2 ISRs for the
+ *          tach pins, and TIMER1_OVF (see PWM_hooks.h to put a hook on
+ *          it). A sketch that also uses SoftwareSerial or another
+ *          library with pin change ISRs has to define PWM_USER_PCINT
+ *          for the whole build (a compiler flag, not a #define in the
+ *          sketch) to leave them out. Tach edges are then only counted
+ *          if PWM_controlPinChange() is called from a pin change ISR.
+ */
+
+#ifndef PWM_CONTROL_H
+#define PWM_CONTROL_H
+
+#include <stdint.h>
+#include "PWM.h"
+
+/** @brief Most channels that can be controlled at once */
+#ifndef PWM_CONTROL_MAX
+    #define PWM_CONTROL_MAX 6
+#endif
+
+/**
+ * @struct  PWM_CONTROL
+ * @brief   Settings and state of one controlled output
+ */
+typedef struct {
+    PWM_PIN pin;            ///< PWM output being controlled
+    uint8_t tachPin;        ///< Digital pin the tach signal is on
+    int16_t kp;             ///< Proportional gain, Q8.8
+    int16_t ki;             ///< Integral gain, Q8.8
+    int16_t kd;             ///< Derivative gain on the measurement, Q8.8
+    uint16_t outMax;        ///< Highest OCR value written
+    uint16_t setpoint;      ///< Tach edges per loop, Q8.8
+
+    // Used by the library
+    uint16_t measured;      ///< Last measured tach edges per loop, Q8.8
+    uint16_t output;        ///< Last OCR value written
+    int32_t integral;       ///< Integral term in OCR counts, Q8.8
+    uint8_t tachPort;       ///< 0 = PORTB, 1 = PORTC, 2 = PORTD
+    uint8_t tachMask;       ///< Bit of the tach pin in its port
+    volatile uint8_t edges; ///< Rising edges counted since the last loop
+} PWM_CONTROL;
+
+/**
+ * @brief   Adds a channel to the control loop
+ *
+ * @details Sets up the tach pin as an input with a pull-up (most fan
+ *          tach outputs are open collector) and turns on its pin change
+ *          interrupt. The PWM output should already be set up.
+ *
+ * @param   ctrl    A PWM_CONTROL pointer with the pins, gains and limits
+ *                  filled in. It has to stay around while it's used.
+ *
+ * @return  INVALID_PWM_PIN if a pin isn't valid, UNDEFINED_PWM_VALUE if
+ *          there are already PWM_CONTROL_MAX channels, otherwise
+ *          NO_PWM_ERROR.
+ */
+PWM_LOG PWM_controlAdd(PWM_CONTROL *ctrl);
+
+/**
+ * @brief   Starts running the control loop
+ *
+ * @details The loop rate is the Timer1 overflow rate divided by
+ *          divider. With the Arduino default settings that is
+ *          490.2 Hz / divider, worked out from the timer settings.
+ *
+ * @param   divider uint8_t type. Timer1 overflows per loop, 0 stops the loop
+ *                  and turns the overflow interrupt off if nothing else
+ *                  is using it.
+ *
+ * @return  UNDEFINED_PWM_VALUE if the space vector PWM of PWM_svpwm.h
+ *          is running or a hook has TIMER1_OVF without PWM_HOOK_CONTROL,
+ *          otherwise NO_PWM_ERROR.
+ */
+PWM_LOG PWM_controlBegin(uint8_t divider);
+
+/**
+ * @brief   Changes the setpoint of a channel
+ *
+ * @param   ctrl        A PWM_CONTROL pointer given to PWM_controlAdd()
+ *
+ * @param   setpoint    uint16_t type. Tach edges per loop, Q8.8.
+ */
+void PWM_controlSetpoint(PWM_CONTROL *ctrl, uint16_t setpoint);
+
+/**
+ * @brief   Counts the tach edges on every port
+ *
+ * @details Only needed when PWM_USER_PCINT is defined, from the pin
+ *          change ISRs that replace the library's.
+ */
+void PWM_controlPinChange(void);
+
+/**
+ * @brief   Runs one step of the loop for every channel
+ *
+ * @details Called from the Timer1 overflow interrupt by
+ *          PWM_controlTick(). It shouldn't be called anywhere else.
+ */
+void PWM_controlRun(void);
+
+extern uint8_t PWM_controlDivider;
+extern uint8_t PWM_controlCount;
+
+/** @brief Counts Timer1 overflows and runs the loop when it's time */
+static inline void PWM_controlTick(void){
+    if(PWM_controlDivider && (++PWM_controlCount >= PWM_controlDivider)){
+        PWM_controlCount = 0;
+        PWM_controlRun();
+    }
+}
+
+#endif /*PWM_CONTROL_H*/
@@ -0,0 +1,118 @@
+/**
+ * @file    PWM_dither.h
+ * @date    Oct 19 2026
+ * @author  Amulek1416
+ *
+ * @brief   Dithered PWM for the 8-bit timers to get 16 bits of
+ *          resolution on pins 3, 5, 6 and 11.
+ *
+ * @details The value given is the OCR value with 8 extra bits for
+ *          the fraction (0x8040 is an OCR of 128.25). Once every
+ *          period, an interrupt adds the fraction to an accumulator
+ *          (first-order sigma-delta) and sets OCRnx to the whole
+ *          part, plus one when the accumulator carries. Over 256
+ *          periods the average is exactly the value that was given.
+ *
+ *          Timer2 (pins 3 and 11) uses the overflow interrupt. The
+ *          Arduino core already uses the Timer0 overflow interrupt
+ *          for millis(), so Timer0 (pins 5 and 6) uses the compare
+ *          match A interrupt, which only happens once a period in
+ *          fast PWM mode.
+ *
+ *          tools/host/dither_spectrum.cpp runs the interrupt on a PC.
+ *          The average is exact over every 256 periods and no tone is
+ *          bigger than half an OCR count. The lowest tone is at the PWM
+ *          frequency / 256 (122.5 Hz at 31.37 kHz) when the fraction is
+ *          odd, and goes up as the fraction gets more even (7.8 kHz for
+ *          0x40).
+ *
+ *          Counted from the AVR instructions PWM_ditherStep() needs
+ *          (lds, add, adc and sts, with no call), a dithered channel
+ *          takes about 16 cycles and one that isn't dithered 5. The
+ *          interrupt entry and exit add about 35 more, once for both
+ *          pins of a timer. CYCLE_TEST in PWM-lib.ino prints the cycles
+ *          of the Timer2 work with 0, 1 and 2 pins dithered on a board.
+ *
+ * @warning The dither noise is at the PWM frequency divided by up to
+ *          256, so the output filter has to be designed for that.
+ *
+ * @warning The library has the TIMER2_OVF and TIMER0_COMPA ISRs. To put
+ *          a hook on them, see PWM_hooks.h.
+ */
+
+#ifndef PWM_DITHER_H
+#define PWM_DITHER_H
+
+#include <stdint.h>
+#include <avr/io.h>
+#include "PWM.h"
+
+/** @brief State of a dithered channel, only used inside the library */
+typedef struct {
+    uint8_t whole;      ///< OCR value without the fraction
+    uint8_t fraction;   ///< Added to error every period
+    uint8_t error;      ///< Sigma-delta accumulator
+    bool enabled;
+} PWM_DITHER_CHANNEL;
+
+// Index of every pin in PWM_ditherChannel
+#define PWM_DITHER_3    0
+#define PWM_DITHER_11   1
+#define PWM_DITHER_5    2
+#define PWM_DITHER_6    3
+
+extern volatile PWM_DITHER_CHANNEL PWM_ditherChannel[4];
+
+// Only needs a few instructions, so it is inlined into each ISR
+// with the OCR register known at compile time
+static inline void PWM_ditherStep(volatile PWM_DITHER_CHANNEL *ch, volatile uint8_t *ocr){
+    if(ch->enabled){
+        uint16_t sum = ch->error + ch->fraction;
+        ch->error = (uint8_t)sum;
+        *ocr = ch->whole + (uint8_t)(sum >> 8);
+    }
+}
+
+/** @brief Dither work done once a period for pins 5 and 6 */
+static inline void PWM_ditherTimer0(void){
+    PWM_ditherStep(&PWM_ditherChannel[PWM_DITHER_5], &OCR0B);
+    PWM_ditherStep(&PWM_ditherChannel[PWM_DITHER_6], &OCR0A);
+}
+
+/** @brief Dither work done once a period for pins 3 and 11 */
+static inline void PWM_ditherTimer2(void){
+    PWM_ditherStep(&PWM_ditherChannel[PWM_DITHER_3], &OCR2B);
+    PWM_ditherStep(&PWM_ditherChannel[PWM_DITHER_11], &OCR2A);
+}
+
+/**
+ * @brief   Turns on dithering for a pin and sets its 16-bit value
+ *
+ * @details Can be called again at any time to change the value.
+ *
+ * @param   pin     PWM_PIN type. Has to be a pin on an 8-bit timer
+ *                  (_3, _5, _6 or _11).
+ *
+ * @param   value   uint16_t type. OCR value in the upper byte and the
+ *                  fraction in the lower byte.
+ *
+ * @return  INVALID_PWM_PIN for pins on Timer1, UNDEFINED_PWM_VALUE if
+ *          the timer isn't in a PWM mode, Timer0 isn't in fast PWM, the
+ *          pin's OCR is TOP (pins 6 and 11 with WGM 5 or 7) or a hook
+ *          has the timer's vector without PWM_HOOK_DITHER, otherwise
+ *          NO_PWM_ERROR.
+ */
+PWM_LOG setDitheredDuty(PWM_PIN pin, uint16_t value);
+
+/**
+ * @brief   Turns off dithering for a pin
+ *
+ * @details The pin is left at the whole part of its last value. The
+ *          timer interrupt is turned off once no pin on that timer is
+ *          dithered anymore.
+ *
+ * @param   pin     PWM_PIN type. Has to be _3, _5, _6 or _11.
+ */
+PWM_LOG stopDither(PWM_PIN pin);
+
+#endif /*PWM_DITHER_H*/
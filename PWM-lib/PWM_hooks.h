@@ -0,0 +1,204 @@
+/**
+ * @file    PWM_hooks.h
+ * @date    Oct 19 2026
+ * @author  Amulek1416
+ *
+ * @brief   Runs your own code on the overflow or compare match
+ *          interrupts of the PWM timers.
+ *
+ * @details A hook is written like a function with one of the macros
+ *          below, in one of your own files. The macro writes the ISR
+ *          for that vector with the hook inlined into it, so there
+ *          are no function pointers and nothing is looked up at run
+ *          time. Hooks that aren't written don't exist, so they take
+ *          no flash and no cycles.
+ *
+ *          The library already has ISRs for TIMER2_OVF and
+ *          TIMER0_COMPA for dithering (see PWM_dither.h) and TIMER1_OVF
+ *          for the control loop and space vector PWM (see PWM_control.h
+ *          and PWM_svpwm.h). To put a hook on one of those, define
+ *          PWM_USER_TIMER2_OVF, PWM_USER_TIMER0_COMPA or
+ *          PWM_USER_TIMER1_OVF for the whole build (a compiler flag
+ *          like -DPWM_USER_TIMER2_OVF, since the library's files don't
+ *          see the sketch's #defines). The library's ISR is left out
+ *          and the hook takes its place. Without the define the hook
+ *          doesn't compile.
+ *
+ *          The hook only does the library's work for the modules named
+ *          with PWM_HOOK_DITHER, PWM_HOOK_CONTROL and PWM_HOOK_SVPWM
+ *          (also for the whole build), so a hook has nothing in it for
+ *          modules that aren't used. setDitheredDuty() and
+ *          PWM_controlBegin() return UNDEFINED_PWM_VALUE if their
+ *          vector has a hook without their work in it.
+ *
+ *          The hook gets the PWM_SIG given to PWM_init() for the pin,
+ *          or NULL if PWM_init() wasn't used. The setters in PWM.h keep
+ *          it up to date, but values written straight to the registers
+ *          (setCompareValue(), dithering, servos) aren't in it.
+ *
+ * @code
+ *  PWM_ON_COMPARE(_9, pwm){
+ *      if(pwm->output == PWM_ENABLE)
+ *          PORTB ^= _BV(PORTB5);
+ *  }
+ *  // ...
+ *  enableHook(_9, PWM_HOOK_COMPARE);
+ * @endcode
+ *
+ *          CYCLE_TEST in PWM-lib.ino times a hook against the same
+ *          code in a bare ISR().
+ *
+ * @warning The Arduino core uses the Timer0 overflow interrupt for
+ *          millis(), so pins 5 and 6 have no PWM_ON_OVERFLOW(). Pins
+ *          on the same timer share the overflow interrupt, so only
+ *          one PWM_ON_OVERFLOW() can be written for each timer.
+ */
+
+#ifndef PWM_HOOKS_H
+#define PWM_HOOKS_H
+
+#include <stdint.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "PWM.h"
+#include "PWM_dither.h"
+#include "PWM_control.h"
+#include "PWM_svpwm.h"
+
+/** @brief The interrupts a hook can be put on */
+typedef enum PWM_HOOK {
+    PWM_HOOK_OVERFLOW   = 0,
+    PWM_HOOK_COMPARE    = 1
+} PWM_HOOK;
+
+// Vector and library work for the compare match of every pin
+#define PWM_COMPARE_VECT__3     TIMER2_COMPB_vect
+#define PWM_COMPARE_VECT__5     TIMER0_COMPB_vect
+#define PWM_COMPARE_VECT__6     TIMER0_COMPA_vect
+#define PWM_COMPARE_VECT__9     TIMER1_COMPA_vect
+#define PWM_COMPARE_VECT__10    TIMER1_COMPB_vect
+#define PWM_COMPARE_VECT__11    TIMER2_COMPA_vect
+
+// Library work for each module, empty unless it is named for the build
+#ifdef PWM_HOOK_DITHER
+    #define PWM_HOOK_TIMER0_DITHER()    PWM_ditherTimer0()
+    #define PWM_HOOK_TIMER2_DITHER()    PWM_ditherTimer2()
+#else
+    #define PWM_HOOK_TIMER0_DITHER()
+    #define PWM_HOOK_TIMER2_DITHER()
+#endif
+#ifdef PWM_HOOK_SVPWM
+    #define PWM_HOOK_TIMER1_SVPWM()     PWM_svpwmTick()
+#else
+    #define PWM_HOOK_TIMER1_SVPWM()
+#endif
+#ifdef PWM_HOOK_CONTROL
+    #define PWM_HOOK_TIMER1_CONTROL()   PWM_controlTick()
+#else
+    #define PWM_HOOK_TIMER1_CONTROL()
+#endif
+
+// 1 when the library's ISR for a vector is left out, so a hook can have it
+#ifdef PWM_USER_TIMER0_COMPA
+    #define PWM_HOOK_FREE_TIMER0_COMPA  1
+#else
+    #define PWM_HOOK_FREE_TIMER0_COMPA  0
+#endif
+#ifdef PWM_USER_TIMER1_OVF
+    #define PWM_HOOK_FREE_TIMER1_OVF    1
+#else
+    #define PWM_HOOK_FREE_TIMER1_OVF    0
+#endif
+#ifdef PWM_USER_TIMER2_OVF
+    #define PWM_HOOK_FREE_TIMER2_OVF    1
+#else
+    #define PWM_HOOK_FREE_TIMER2_OVF    0
+#endif
+
+#define PWM_COMPARE_WORK__3()
+#define PWM_COMPARE_WORK__5()
+#define PWM_COMPARE_WORK__6()   PWM_HOOK_TIMER0_DITHER()
+#define PWM_COMPARE_WORK__9()
+#define PWM_COMPARE_WORK__10()
+#define PWM_COMPARE_WORK__11()
+
+#define PWM_COMPARE_FREE__3     1
+#define PWM_COMPARE_FREE__5     1
+#define PWM_COMPARE_FREE__6     PWM_HOOK_FREE_TIMER0_COMPA
+#define PWM_COMPARE_FREE__9     1
+#define PWM_COMPARE_FREE__10    1
+#define PWM_COMPARE_FREE__11    1
+
+// Vector and library work for the overflow of every pin's timer
+#define PWM_OVERFLOW_VECT__3    TIMER2_OVF_vect
+#define PWM_OVERFLOW_VECT__9    TIMER1_OVF_vect
+#define PWM_OVERFLOW_VECT__10   TIMER1_OVF_vect
+#define PWM_OVERFLOW_VECT__11   TIMER2_OVF_vect
+
+#define PWM_OVERFLOW_WORK__3()  PWM_HOOK_TIMER2_DITHER()
+#define PWM_OVERFLOW_WORK__9()  PWM_HOOK_TIMER1_SVPWM(); PWM_HOOK_TIMER1_CONTROL()
+#define PWM_OVERFLOW_WORK__10() PWM_HOOK_TIMER1_SVPWM(); PWM_HOOK_TIMER1_CONTROL()
+#define PWM_OVERFLOW_WORK__11() PWM_HOOK_TIMER2_DITHER()
+
+#define PWM_OVERFLOW_FREE__3    PWM_HOOK_FREE_TIMER2_OVF
+#define PWM_OVERFLOW_FREE__9    PWM_HOOK_FREE_TIMER1_OVF
+#define PWM_OVERFLOW_FREE__10   PWM_HOOK_FREE_TIMER1_OVF
+#define PWM_OVERFLOW_FREE__11   PWM_HOOK_FREE_TIMER2_OVF
+
+/**
+ * @brief   Writes a hook for the compare match interrupt of a pin
+ *
+ * @param   pin     _3, _5, _6, _9, _10 or _11
+ *
+ * @param   sig     Name of the PWM_SIG pointer given to the hook
+ */
+#define PWM_ON_COMPARE(pin, sig) \
+    static_assert(PWM_COMPARE_FREE_##pin, "The library has this vector, see PWM_USER_ in PWM_hooks.h"); \
+    static inline void pwmCompareHook##pin(PWM_SIG *sig) __attribute__((always_inline)); \
+    ISR(PWM_COMPARE_VECT_##pin){ \
+        PWM_COMPARE_WORK_##pin(); \
+        pwmCompareHook##pin(PWM_signals[PWM_CHANNEL_##pin]); \
+    } \
+    static inline void pwmCompareHook##pin(PWM_SIG *sig)
+
+/**
+ * @brief   Writes a hook for the overflow interrupt of a pin's timer
+ *
+ * @param   pin     _3, _9, _10 or _11
+ *
+ * @param   sig     Name of the PWM_SIG pointer given to the hook
+ */
+#define PWM_ON_OVERFLOW(pin, sig) \
+    static_assert(PWM_OVERFLOW_FREE_##pin, "The library has this vector, see PWM_USER_ in PWM_hooks.h"); \
+    static inline void pwmOverflowHook##pin(PWM_SIG *sig) __attribute__((always_inline)); \
+    ISR(PWM_OVERFLOW_VECT_##pin){ \
+        PWM_OVERFLOW_WORK_##pin(); \
+        pwmOverflowHook##pin(PWM_signals[PWM_CHANNEL_##pin]); \
+    } \
+    static inline void pwmOverflowHook##pin(PWM_SIG *sig)
+
+/**
+ * @brief   Turns on the interrupt a hook is written for
+ *
+ * @param   pin     PWM_PIN type.
+ *
+ * @param   hook    PWM_HOOK type.
+ *
+ * @return  INVALID_PWM_PIN for PWM_HOOK_OVERFLOW on pins 5 and 6,
+ *          otherwise NO_PWM_ERROR.
+ */
+PWM_LOG enableHook(PWM_PIN pin, PWM_HOOK hook);
+
+/**
+ * @brief   Turns off the interrupt a hook is written for
+ *
+ * @details The interrupt is left on if the library still needs it
+ *          for dithering, the control loop or space vector PWM.
+ *
+ * @param   pin     PWM_PIN type.
+ *
+ * @param   hook    PWM_HOOK type.
+ */
+PWM_LOG disableHook(PWM_PIN pin, PWM_HOOK hook);
+
+#endif /*PWM_HOOKS_H*/
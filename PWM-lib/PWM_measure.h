@@ -0,0 +1,171 @@
+/**
+ * @file    PWM_measure.h
+ * @date    Oct 19 2026
+ * @author  Amulek1416
+ *
+ * @brief   Measures the real output of a PWM pin using the
+ *          Timer1 input capture unit (ICP1).
+ *
+ * @details The PWM pin being checked has to be looped back
+ *          (wired) to the input capture pin (pin 8 on the Uno).
+ *          Every edge is timestamped by the hardware in ICR1,
+ *          so the interrupt latency doesn't affect the result.
+ *          The high times and periods of PWM_MEASURE_BATCH
+ *          periods are added together and averaged.
+ *
+ * @warning Timer1 is borrowed while a measurement is running,
+ *          so pins 9 and 10 can't be measured and will stop
+ *          producing their signal until it finishes. The capture
+ *          interrupt has to handle every edge, so a signal with a
+ *          high or low time of only around a hundred CPU cycles (like
+ *          62.5 kHz fast PWM) gives PWM_MEASURE_OVERRUN.
+ *
+ * @warning The library has the TIMER1_CAPT ISR. If something else needs
+ *          it too, define PWM_USER_TIMER1_CAPT for the whole build (a
+ *          compiler flag, not a #define in the sketch) to leave it out,
+ *          and call PWM_measureCapture() from your own ISR.
+ */
+
+#ifndef PWM_MEASURE_H
+#define PWM_MEASURE_H
+
+#include <stdint.h>
+#include "PWM.h"
+
+/** @brief Number of periods averaged in a single measurement (1-16) */
+#ifndef PWM_MEASURE_BATCH
+    #define PWM_MEASURE_BATCH 8
+#endif
+
+#if (PWM_MEASURE_BATCH < 1) || (PWM_MEASURE_BATCH > 16)
+    #error "PWM_MEASURE_BATCH must be between 1 and 16"
+#endif
+
+/** @brief Allowed frequency deviation used by PWM_verify(), in 1/1000 */
+#ifndef PWM_VERIFY_FREQ_TOL
+    #define PWM_VERIFY_FREQ_TOL 10
+#endif
+
+/** @brief Allowed duty cycle deviation used by PWM_verify(), in 1/100 % */
+#ifndef PWM_VERIFY_DUTY_TOL
+    #define PWM_VERIFY_DUTY_TOL 100
+#endif
+
+/**
+ * @struct  PWM_MEASUREMENT
+ * @brief   Result of a measurement and how far it is from the
+ *          settings in the PWM_SIG that was measured.
+ */
+typedef struct {
+    uint32_t frequency;     ///< Measured frequency in 1/100 Hz
+    uint16_t dutyCycle;     ///< Measured duty cycle in 1/100 %
+    int32_t  freqError;     ///< Measured minus expected frequency in 1/100 Hz
+    int16_t  dutyError;     ///< Measured minus expected duty cycle in 1/100 %
+} PWM_MEASUREMENT;
+
+/**
+ * @brief   Gives the frequency of a PWM_FREQUENCY value
+ *
+ * @details The PWM_FREQUENCY values are for the modes the Arduino core
+ *          starts with (fast PWM on Timer0, phase correct on Timers 1
+ *          and 2). Use PWM_pinFreq() for what a pin is really doing.
+ *
+ * @param   freq    PWM_FREQUENCY type to convert
+ *
+ * @return  The frequency in 1/100 Hz, or 0 if it isn't a valid frequency
+ */
+uint32_t PWM_freqToCentiHz(PWM_FREQUENCY freq);
+
+/**
+ * @brief   Works out the frequency of a pin from the mode (WGM) and
+ *          prescaler (CS) its timer is set to right now
+ *
+ * @param   pin     PWM_PIN type.
+ *
+ * @return  The frequency in 1/100 Hz, or 0 if the timer is stopped,
+ *          on an external clock or not in a PWM mode
+ */
+uint32_t PWM_pinFreq(PWM_PIN pin);
+
+/**
+ * @brief   Starts measuring the signal on the input capture pin
+ *          without blocking.
+ *
+ * @details Timer1 is switched to normal mode with a prescaler
+ *          picked from the frequency of the pin (PWM_pinFreq()) so
+ *          that a full period always fits in the 16-bit counter.
+ *          Use PWM_measureDone() and PWM_measureResult() to get
+ *          the result.
+ *
+ * @param   pwm     A PWM_SIG pointer with the expected settings
+ *
+ * @return  INVALID_PWM_PIN if the pin uses Timer1, INVALID_PWM_FREQ if
+ *          the pin's timer isn't running in a PWM mode, otherwise
+ *          NO_PWM_ERROR.
+ */
+PWM_LOG PWM_measureStart(PWM_SIG *pwm);
+
+/**
+ * @brief   Checks if the measurement started by PWM_measureStart()
+ *          has finished.
+ *
+ * @details The timeout is counted in here from the Timer1 overflows,
+ *          so it has to be called repeatedly while waiting.
+ *
+ * @return  true once the measurement is finished, failed or timed out.
+ */
+bool PWM_measureDone(void);
+
+/**
+ * @brief   Gives the result of the last measurement and gives Timer1
+ *          back to the settings it had before PWM_measureStart().
+ *
+ * @param   pwm     The same PWM_SIG pointer given to PWM_measureStart()
+ *
+ * @param   result  Where the measured values will be stored
+ *
+ * @return  PWM_MEASURE_TIMEOUT if not enough edges were seen,
+ *          PWM_MEASURE_OVERRUN if an edge was missed, otherwise
+ *          NO_PWM_ERROR.
+ */
+PWM_LOG PWM_measureResult(PWM_SIG *pwm, PWM_MEASUREMENT *result);
+
+/**
+ * @brief   Measures a PWM signal and waits for the result
+ *
+ * @details Takes at most (2 * PWM_MEASURE_BATCH + 4) Timer1 overflows,
+ *          which is about 0.6 s for the slowest frequencies.
+ *
+ * @param   pwm     A PWM_SIG pointer with the expected settings
+ *
+ * @param   result  Where the measured values will be stored
+ */
+PWM_LOG PWM_measure(PWM_SIG *pwm, PWM_MEASUREMENT *result);
+
+/**
+ * @brief   Handles one captured edge
+ *
+ * @details Only needed when PWM_USER_TIMER1_CAPT is defined, from the
+ *          TIMER1_CAPT ISR that replaces the library's.
+ */
+void PWM_measureCapture(void);
+
+/**
+ * @brief   Measures a PWM signal and checks it against its settings
+ *
+ * @details The frequency is checked against PWM_pinFreq(), so it is
+ *          right for every mode and not just the Arduino defaults. A
+ *          duty cycle of 0% or 100% has no edges, so only the level of
+ *          the pin is checked for those.
+ *
+ * @param   pwm     A PWM_SIG pointer with the expected settings
+ *
+ * @param   result  Where the measured values will be stored
+ *
+ * @return  INVALID_PWM_FREQ or INVALID_PWM_DUTY_CYCLE_VALUE when the
+ *          signal is off by more than PWM_VERIFY_FREQ_TOL or
+ *          PWM_VERIFY_DUTY_TOL, or any error from PWM_measure().
+ */
+PWM_LOG PWM_verify(PWM_SIG *pwm, PWM_MEASUREMENT *result);
+
+#endif /*PWM_MEASURE_H*/
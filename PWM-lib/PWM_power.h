@@ -0,0 +1,100 @@
+/**
+ * @file    PWM_power.h
+ * @date    Oct 19 2026
+ * @author  Amulek1416
+ *
+ * @brief   Turns off the clock of timers that have no outputs and
+ *          picks the deepest sleep mode that keeps the PWM running.
+ *
+ * @details When setOutputType() disables a pin, its timer is shut down
+ *          in the Power Reduction Register (PRR) if neither pin of the
+ *          timer has an output connected (COMnA/COMnB in TCCRnA) and
+ *          none of the timer's interrupts are on. Every function that writes
+ *          to a timer turns it back on first with PWM_powerOn(), and
+ *          shuts it down again afterwards with PWM_powerUpdate() if
+ *          nothing uses it, so a write to a pin with its output off
+ *          doesn't leave the timer running. The hardware keeps the
+ *          timer's registers while it is shut down, so it carries on
+ *          exactly where it stopped.
+ *
+ *          Current saved by shutting a timer down, from the ATmega328P
+ *          datasheet ("Additional current consumption for the different
+ *          I/O modules") at 5 V and 8 MHz. It goes up about linearly
+ *          with the clock, so it is about double on a 16 MHz Uno:
+ *          | Timers shut down | Saved at 8 MHz | Saved at 16 MHz |
+ *          |------------------|----------------|-----------------|
+ *          | Timer0           | ~32 uA         | ~64 uA          |
+ *          | Timer1           | ~95 uA         | ~190 uA         |
+ *          | Timer2           | ~111 uA        | ~222 uA         |
+ *          | Timer1 + Timer2  | ~206 uA        | ~413 uA         |
+ *          | All three        | ~239 uA        | ~477 uA         |
+ *          PWM_powerSaved() adds these up for the current settings.
+ *
+ * @warning analogWrite() from the Arduino core doesn't turn a timer back
+ *          on. Its writes to a shut down timer are silently ignored, so
+ *          call PWM_powerOn() for the pin before using it.
+ *
+ * @warning The Arduino core uses Timer0 for millis() and delay(), so
+ *          Timer0 is only shut down if PWM_GATE_TIMER0 is defined. Its
+ *          overflow interrupt is left out of the check then, and
+ *          millis() stops while Timer0 is shut down.
+ */
+
+#ifndef PWM_POWER_H
+#define PWM_POWER_H
+
+#include <stdint.h>
+#include "PWM.h"
+
+/**
+ * @brief   Turns a pin's timer back on if it was shut down
+ *
+ * @param   pin     PWM_PIN type.
+ */
+void PWM_powerOn(PWM_PIN pin);
+
+/**
+ * @brief   Turns a pin's timer on when its output is enabled, or shuts
+ *          it down if nothing is using it anymore
+ *
+ * @details Called by setOutputType(), and with active false by every
+ *          function that writes to a timer once it is done. There should
+ *          be no need to call it anywhere else.
+ *
+ * @param   pin     PWM_PIN type.
+ *
+ * @param   active  bool type. true if the output is enabled.
+ */
+void PWM_powerUpdate(PWM_PIN pin, bool active);
+
+/**
+ * @brief   Gives the deepest sleep mode that keeps every running
+ *          timer running
+ *
+ * @details Timer0 and Timer1 (and Timer2 on the normal clock) need the
+ *          I/O clock, so only SLEEP_MODE_IDLE keeps them going. An
+ *          asynchronous Timer2 keeps going in SLEEP_MODE_PWR_SAVE.
+ *          With no timers running, SLEEP_MODE_PWR_DOWN is used.
+ *
+ * @return  One of the SLEEP_MODE_ values from avr/sleep.h
+ */
+uint8_t PWM_sleepMode(void);
+
+/**
+ * @brief   Sleeps in the mode given by PWM_sleepMode() until the
+ *          next interrupt
+ *
+ * @warning SLEEP_MODE_PWR_DOWN can only be woken up by an external or
+ *          pin change interrupt, the watchdog or TWI address match.
+ */
+void PWM_sleep(void);
+
+/**
+ * @brief   Gives the expected current saved by the timers that are
+ *          shut down right now
+ *
+ * @return  The current in uA, scaled for F_CPU
+ */
+uint16_t PWM_powerSaved(void);
+
+#endif /*PWM_POWER_H*/
@@ -0,0 +1,144 @@
+/**
+ * @file    PWM_serial.h
+ * @date    Oct 19 2026
+ * @author  Amulek1416
+ *
+ * @brief   Binary protocol to change PWM settings over a serial port.
+ *
+ * @details Every frame holds a batch of updates. Each byte is copied
+ *          once from the serial receive buffer into a frame buffer, and
+ *          the frame is checked and applied from there without being
+ *          parsed into text. The whole batch is applied with interrupts
+ *          off so the outputs all change together.
+ *
+ *          Frame sent to the board (all values little endian):
+ *          | Byte          | Meaning                                   |
+ *          |---------------|-------------------------------------------|
+ *          | 0             | PWM_FRAME_SYNC                            |
+ *          | 1             | LEN, bytes of updates (4 per update)      |
+ *          | 2             | SEQ, copied into the acknowledgement      |
+ *          | 3 ... 2+LEN   | Updates: pin, PWM_FIELD, value (2 bytes)  |
+ *          | 3+LEN, 4+LEN  | CRC-16/CCITT-FALSE of bytes 1 ... 2+LEN   |
+ *
+ *          Acknowledgement sent back:
+ *          | Byte  | Meaning                                           |
+ *          |-------|---------------------------------------------------|
+ *          | 0     | PWM_ACK_SYNC                                      |
+ *          | 1     | SEQ of the frame                                  |
+ *          | 2     | PWM_LOG of the first update that failed           |
+ *          | 3     | Index of that update, 0xFF if none failed         |
+ *          | 4, 5  | CRC-16/CCITT-FALSE of bytes 1 ... 3               |
+ *
+ *          If any update in a frame is invalid (bad pin, field or enum
+ *          value, or a frequency the pin's timer can't make) nothing in
+ *          the frame is applied. A frame with a bad LEN is acknowledged
+ *          with INVALID_PWM_FRAME as soon as its SEQ has arrived, and so
+ *          is a frame with a bad CRC. If no byte comes in for
+ *          PWM_SERIAL_TIMEOUT_MS in the middle of a frame, a byte was
+ *          lost, so the frame is dropped (and acknowledged with
+ *          INVALID_PWM_FRAME if its SEQ arrived) instead of being joined
+ *          to the next one. The sender should leave at least that long
+ *          before resending.
+ *
+ *          A full frame of 16 updates is 69 bytes, or 690 bit times
+ *          with a start and stop bit. So the line alone limits 115200
+ *          baud to about 167 frames or 2670 updates a second, and
+ *          1 Mbaud to about 23000 updates. Those figures come from the
+ *          frame size and weren't measured.
+ *
+ *          tools/host/serial_loopback.py runs the decoder on the PC
+ *          over a pseudo terminal. It checks good and bad frames, then
+ *          times a burst of full frames and prints the frames and
+ *          updates a second. A pseudo terminal has no baud rate, so
+ *          that measures the decoder and not the line. It managed
+ *          12000 to 15000 frames (190000 to 240000 updates) a second.
+ *
+ *          A reference encoder for the host is in tools/pwm_frame.py.
+ */
+
+#ifndef PWM_SERIAL_H
+#define PWM_SERIAL_H
+
+#include <stdint.h>
+#include "PWM.h"
+
+class Stream;
+
+/** @brief Most updates in a single frame */
+#ifndef PWM_SERIAL_MAX_UPDATES
+    #define PWM_SERIAL_MAX_UPDATES 16
+#endif
+
+/** @brief Longest gap between two bytes of a frame, in milliseconds */
+#ifndef PWM_SERIAL_TIMEOUT_MS
+    #define PWM_SERIAL_TIMEOUT_MS 50
+#endif
+
+/** @brief First byte of a frame */
+#define PWM_FRAME_SYNC  0xA5
+
+/** @brief First byte of an acknowledgement */
+#define PWM_ACK_SYNC    0x5A
+
+/** @brief Bytes in a single update */
+#define PWM_UPDATE_SIZE 4
+
+/**
+ * @brief   PWM_SIG field changed by an update
+ *
+ * @details The value of every update is given to the function in
+ *          brackets. PWM_FIELD_ADV_MODE has the PWM_MODE in the upper
+ *          byte and the PWM_ADV_MODE in the lower byte.
+ */
+typedef enum PWM_FIELD {
+    PWM_FIELD_FREQUENCY = 0,    ///< (setFreq)
+    PWM_FIELD_MODE      = 1,    ///< (setMode)
+    PWM_FIELD_ADV_MODE  = 2,    ///< (setAdvancedMode)
+    PWM_FIELD_OUTPUT    = 3,    ///< (setOutputType)
+    PWM_FIELD_DUTY      = 4,    ///< (setDutyCycle)
+    PWM_FIELD_COMPARE   = 5     ///< (setCompareValue)
+} PWM_FIELD;
+
+/**
+ * @brief   Applies the updates of a frame that is already in memory
+ *
+ * @details The PWM_SIG given to PWM_init() for each pin is updated by
+ *          the setters when they succeed, so it always matches what the
+ *          board is doing.
+ *
+ * @param   updates     Pointer to the first update of the frame
+ *
+ * @param   length      Bytes of updates (LEN)
+ *
+ * @param   index       Set to the index of the first update that failed,
+ *                      0xFF if none did
+ *
+ * @return  PWM_LOG of the first update that failed, otherwise NO_PWM_ERROR
+ */
+PWM_LOG PWM_applyFrame(const uint8_t *updates, uint8_t length, uint8_t *index);
+
+/**
+ * @brief   Reads what has come in on a serial port and applies
+ *          a frame once all of it has arrived
+ *
+ * @details Doesn't block. Call it from loop() as often as possible.
+ *          Bytes before a PWM_FRAME_SYNC are skipped, and a frame with a
+ *          gap of more than PWM_SERIAL_TIMEOUT_MS between two bytes is
+ *          dropped.
+ *
+ * @param   port    Serial port to read from and acknowledge on
+ *
+ * @return  true if a frame was finished or dropped and acknowledged
+ */
+bool PWM_serialPoll(Stream &port);
+
+/**
+ * @brief   CRC-16/CCITT-FALSE (poly 0x1021, starts at 0xFFFF)
+ *
+ * @param   data    Bytes to check
+ *
+ * @param   length  Number of bytes
+ */
+uint16_t PWM_crc16(const uint8_t *data, uint8_t length);
+
+#endif /*PWM_SERIAL_H*/
@@ -0,0 +1,112 @@
+/**
+ * @file    PWM_servo.h
+ * @date    Oct 19 2026
+ * @author  Amulek1416
+ *
+ * @brief   Servo and ESC outputs on Timer1 (pins 9 and 10 on the Uno)
+ *          with the pulse width given in microseconds.
+ *
+ * @details PWM_SERVO runs Timer1 in fast PWM mode with ICR1 as TOP and
+ *          a prescaler of 8, which gives 0.5 us steps at 16 MHz. The
+ *          OneShot protocols don't run continuously. The timer runs
+ *          without a prescaler (1/16 us steps) and one pulse is sent
+ *          on every call to triggerPulse(), so the ESC gets updated at
+ *          the same rate as the control loop calling it.
+ *
+ * @warning setFreq(), setMode() and setDutyCycle() on pins 9 and 10
+ *          will undo the settings made here.
+ */
+
+#ifndef PWM_SERVO_H
+#define PWM_SERVO_H
+
+#include <stdint.h>
+#include "PWM.h"
+
+/** @brief Shortest pulse allowed in PWM_SERVO, in us */
+#ifndef PWM_SERVO_MIN_US
+    #define PWM_SERVO_MIN_US 500
+#endif
+
+/** @brief Longest pulse allowed in PWM_SERVO, in us */
+#ifndef PWM_SERVO_MAX_US
+    #define PWM_SERVO_MAX_US 2500
+#endif
+
+/**
+ * @brief   Protocols that can be used for servos and ESCs
+ *
+ * @details Pulse widths allowed for each protocol:
+ *          - PWM_SERVO:        PWM_SERVO_MIN_US - PWM_SERVO_MAX_US
+ *          - PWM_ONESHOT125:   125 - 250 us
+ *          - PWM_ONESHOT42:    42 - 84 us
+ *          - PWM_MULTISHOT:    5 - 25 us
+ */
+typedef enum PWM_SERVO_PROTOCOL {
+    PWM_SERVO       = 0,
+    PWM_ONESHOT125  = 1,
+    PWM_ONESHOT42   = 2,
+    PWM_MULTISHOT   = 3
+} PWM_SERVO_PROTOCOL;
+
+/**
+ * @brief   Sets up Timer1 for servos or ESCs and enables the output
+ *
+ * @details Both pins on Timer1 always use the same protocol, so setting
+ *          a different protocol on the second pin changes the first one.
+ *          The pulse width starts at the shortest one of the protocol.
+ *
+ * @param   pin         PWM_PIN type. Has to be _9 or _10.
+ *
+ * @param   protocol    PWM_SERVO_PROTOCOL type.
+ *
+ * @param   rate        uint16_t type. Frame rate in Hz for PWM_SERVO
+ *                      (31 - 400 Hz). Not used by the OneShot protocols.
+ *
+ * @return  INVALID_PWM_PIN, INVALID_PWM_FREQ if the rate can't fit the
+ *          longest pulse or the 16-bit timer, otherwise NO_PWM_ERROR.
+ */
+PWM_LOG setServoMode(PWM_PIN pin, PWM_SERVO_PROTOCOL protocol, uint16_t rate);
+
+/**
+ * @brief   Sets the pulse width of a servo or ESC output
+ *
+ * @param   pin     PWM_PIN type. Has to be _9 or _10.
+ *
+ * @param   us      uint16_t type. Pulse width in microseconds.
+ *
+ * @return  INVALID_PWM_PIN, INVALID_PWM_PULSE_WIDTH if the width is
+ *          outside the range of the protocol, otherwise NO_PWM_ERROR.
+ */
+PWM_LOG setPulseWidth(PWM_PIN pin, uint16_t us);
+
+/**
+ * @brief   Same as setPulseWidth(), but in 1/16 us
+ *
+ * @details PWM_SERVO rounds this down to 0.5 us. The OneShot
+ *          protocols use the full 1/16 us resolution, which
+ *          matters for PWM_MULTISHOT where 1 us is 5% throttle.
+ *          In the OneShot protocols the new width is kept until the
+ *          next triggerPulse(), so a pulse that is being sent is
+ *          never changed.
+ *
+ * @param   pin         PWM_PIN type. Has to be _9 or _10.
+ *
+ * @param   sixteenths  uint16_t type. Pulse width in 1/16 us.
+ */
+PWM_LOG setPulseWidthFine(PWM_PIN pin, uint16_t sixteenths);
+
+/**
+ * @brief   Sends one pulse on every enabled OneShot output
+ *
+ * @details Both pins start their pulse on the same timer tick. This
+ *          should be called once at the end of every control loop,
+ *          after the new pulse widths have been set.
+ *
+ * @return  PWM_PULSE_BUSY if the last pulse hasn't finished yet,
+ *          UNDEFINED_PWM_VALUE if Timer1 isn't in a OneShot protocol,
+ *          otherwise NO_PWM_ERROR.
+ */
+PWM_LOG triggerPulse(void);
+
+#endif /*PWM_SERVO_H*/
@@ -0,0 +1,150 @@
+/**
+ * @file    PWM_svpwm.h
+ * @date    Oct 19 2026
+ * @author  Amulek1416
+ *
+ * @brief   Center-aligned three-phase space vector PWM to drive
+ *          BLDC and PMSM motors.
+ *
+ * @details Each phase has its own timer, all three in 8-bit phase
+ *          correct mode with no prescaler (31.37 kHz on a 16 MHz Uno):
+ *          | Phase | Pin | Timer  | Register |
+ *          |-------|-----|--------|----------|
+ *          | A     | 9   | Timer1 | OCR1A    |
+ *          | B     | 11  | Timer2 | OCR2A    |
+ *          | C     | 6   | Timer0 | OCR0A    |
+ *          The timers are started together, so their periods all line
+ *          up (within a few CPU cycles) and every pulse is centered on
+ *          the same point.
+ *
+ *          The voltage vector is given as an angle and a magnitude.
+ *          The angle is a full turn in 16 bits (0x4000 is 90 degrees)
+ *          and the magnitude is Q15, where 32767 is the biggest circle
+ *          that fits in the hexagon (line voltage equal to the supply
+ *          at the peak). The duty cycles come from the sector number
+ *          and a table of sines in PROGMEM, with the zero vector split
+ *          evenly between both ends of the period. Only integer math
+ *          is used.
+ *
+ *          New duty cycles are written right after the Timer1 overflow
+ *          (BOTTOM) and the hardware takes all three at the next TOP,
+ *          so every phase changes in the same period. The next values
+ *          are worked out after the write, ready for the update after.
+ *          With a divider of 3 the update rate is 10.46 kHz.
+ *
+ *          tools/host/svpwm_check.cpp checks PWM_svpwmCompute() on a
+ *          PC against the ideal line to line voltages for every angle
+ *          and magnitude. They match within 2 counts and every pulse is
+ *          centered within 1 count. CYCLE_TEST in PWM-lib.ino prints
+ *          the cycles one update takes on a board. All of it has to fit
+ *          in the 512 cycles of a timer period.
+ *
+ * @warning Timer0 is taken from the Arduino core, so millis(), micros()
+ *          and delay() don't work until PWM_svpwmStop(). Pins 3, 5 and
+ *          10 can't be used for PWM while it runs, and dithering on
+ *          pins 6 and 11 has to be off. The control loop of
+ *          PWM_control.h is stopped by PWM_svpwmBegin() and can't be
+ *          started again until PWM_svpwmStop(), there isn't time for
+ *          both in a period. There is no dead time, so the bridge
+ *          driver has to add its own.
+ *
+ * @warning The updates run from the library's TIMER1_OVF ISR. A hook
+ *          that takes it over (see PWM_hooks.h) has to be built with
+ *          PWM_HOOK_SVPWM, or the duty cycles are never updated.
+ */
+
+#ifndef PWM_SVPWM_H
+#define PWM_SVPWM_H
+
+#include <stdint.h>
+#include <avr/io.h>
+#include "PWM.h"
+
+/** @brief Biggest magnitude that stays inside the hexagon */
+#define PWM_SVPWM_MAX   32767
+
+/**
+ * @brief   Sets up the three timers and starts the outputs
+ *
+ * @details All three outputs start at 50% (no voltage across the
+ *          motor) until PWM_svpwmSet() is called. The control loop of
+ *          PWM_control.h is stopped.
+ *
+ * @param   divider uint8_t type. Timer periods per update, 0 stops the
+ *                  updates. 1 is 31.37 kHz, 3 is 10.46 kHz.
+ */
+void PWM_svpwmBegin(uint8_t divider);
+
+/**
+ * @brief   Turns the outputs off and gives the timers back to the
+ *          Arduino core
+ *
+ * @details Timer0 goes back to fast PWM and Timers 1 and 2 to 8-bit
+ *          phase correct, all at clk/64, and millis() runs again. All
+ *          three timers are left powered, so analogWrite() works on
+ *          every pin. Any settings made with setFreq() or setMode()
+ *          before PWM_svpwmBegin() have to be made again.
+ */
+void PWM_svpwmStop(void);
+
+/**
+ * @brief   Sets the voltage vector
+ *
+ * @param   angle       uint16_t type. 65536 is a full electrical turn.
+ *
+ * @param   magnitude   uint16_t type. Q15, capped at PWM_SVPWM_MAX.
+ */
+void PWM_svpwmSet(uint16_t angle, uint16_t magnitude);
+
+/**
+ * @brief   Turns the vector by the same angle every update
+ *
+ * @details The electrical frequency is step * update rate / 65536,
+ *          about 0.16 Hz per step at 10.46 kHz. Useful to start a
+ *          motor open loop before there is any position feedback.
+ *
+ * @param   step    int16_t type. Angle added every update, negative
+ *                  turns the other way. 0 holds the angle.
+ */
+void PWM_svpwmSpeed(int16_t step);
+
+/**
+ * @brief   Works out the duty cycles of a voltage vector
+ *
+ * @details Doesn't touch the timers, so it can be used to check the
+ *          waveforms without a motor.
+ *
+ * @param   angle       uint16_t type. 65536 is a full electrical turn.
+ *
+ * @param   magnitude   uint16_t type. Q15, capped at PWM_SVPWM_MAX.
+ *
+ * @param   duty        Filled with the OCR values of phases A, B and C
+ */
+void PWM_svpwmCompute(uint16_t angle, uint16_t magnitude, uint8_t duty[3]);
+
+/**
+ * @brief   Works out the duty cycles for the next update
+ *
+ * @details Called from the Timer1 overflow interrupt by
+ *          PWM_svpwmTick(). It shouldn't be called anywhere else.
+ */
+void PWM_svpwmRun(void);
+
+extern uint8_t PWM_svpwmNext[3];
+extern uint8_t PWM_svpwmDivider;
+extern uint8_t PWM_svpwmCount;
+extern bool PWM_svpwmOn;
+
+/** @brief Counts Timer1 overflows and writes the duty cycles when it's time */
+static inline void PWM_svpwmTick(void){
+    if(PWM_svpwmDivider && (++PWM_svpwmCount >= PWM_svpwmDivider)){
+        PWM_svpwmCount = 0;
+        // Has to be done before TOP, 255 cycles after the overflow
+        OCR1A = PWM_svpwmNext[0];
+        OCR2A = PWM_svpwmNext[1];
+        OCR0A = PWM_svpwmNext[2];
+        PWM_svpwmRun();
+    }
+}
+
+#endif /*PWM_SVPWM_H*/
@@ -0,0 +1,85 @@
+/**
+ *
+ */
+#include "board_type.h"
+
+#if BOARD == _UNO
+
+#include <Arduino.h>
+#include "PWM.h"
+#include "PWM_brightness.h"
+#include "PWM_power.h"
+
+// setBrightness() reads all three, so all of them (1280 bytes) are in
+// flash once it is used. A sketch that only needs one resolution can
+// make its own table with PWM_BRIGHTNESS_TABLE() and read it directly.
+PWM_BRIGHTNESS_TABLE(uint8_t,  PWM_brightness8,  PWM_BRIGHTNESS_CURVE, 0xFF);
+PWM_BRIGHTNESS_TABLE(uint16_t, PWM_brightness10, PWM_BRIGHTNESS_CURVE, 0x3FF);
+PWM_BRIGHTNESS_TABLE(uint16_t, PWM_brightness16, PWM_BRIGHTNESS_CURVE, PWM_BRIGHTNESS_TOP);
+
+PWM_LOG setBrightness(PWM_PIN pin, uint8_t level){
+    PWM_LOG eFlag = NO_PWM_ERROR;
+    PWM_powerOn(pin);
+
+    switch(pin){
+        case _3:
+            OCR2B = pgm_read_byte(&PWM_brightness8[level]);
+            break;
+        case _5:
+            OCR0B = pgm_read_byte(&PWM_brightness8[level]);
+            break;
+        case _6:
+            OCR0A = pgm_read_byte(&PWM_brightness8[level]);
+            break;
+        case _11:
+            OCR2A = pgm_read_byte(&PWM_brightness8[level]);
+            break;
+        case _9:
+        case _10: {
+            // WGM13:0 is split between TCCR1A and TCCR1B
+            uint8_t wgm = (TCCR1A & (_BV(WGM11) | _BV(WGM10))) |
+                  ((TCCR1B & (_BV(WGM13) | _BV(WGM12))) >> 1);
+            uint16_t ocr;
+            switch(wgm){
+                case 1: // 8-bit phase correct
+                case 5: // 8-bit fast
+                    ocr = pgm_read_byte(&PWM_brightness8[level]);
+                    break;
+                case 2: // 9-bit phase correct
+                case 6: // 9-bit fast
+                    ocr = pgm_read_word(&PWM_brightness10[level]) >> 1;
+                    break;
+                case 3: // 10-bit phase correct
+                case 7: // 10-bit fast
+                    ocr = pgm_read_word(&PWM_brightness10[level]);
+                    break;
+                case 4:  // CTC, OCR1A as TOP
+                case 9:  // Phase and frequency correct, OCR1A as TOP
+                case 11: // Phase correct, OCR1A as TOP
+                case 15: // Fast, OCR1A as TOP
+                    // Writing pin 9 would change TOP instead of the duty cycle
+                    if(pin == _9){
+                        PWM_powerUpdate(pin, false);
+                        return UNDEFINED_PWM_VALUE;
+                    }
+                    ocr = pgm_read_word(&PWM_brightness16[level]);
+                    break;
+                default: // ICR1 or 0xFFFF (normal mode) as TOP
+                    ocr = pgm_read_word(&PWM_brightness16[level]);
+                    break;
+            }
+            if(pin == _9)
+                OCR1A = ocr;
+            else
+                OCR1B = ocr;
+            break;
+        }
+        default:
+            eFlag = INVALID_PWM_PIN;
+            break;
+    }
+    PWM_powerUpdate(pin, false); // Shut down again if nothing uses it
+    return eFlag;
+}
+
+#endif /*BOARD*/
@@ -0,0 +1,211 @@
+/**
+ *
+ */
+#include "board_type.h"
+
+#if BOARD == _UNO
+
+#include <Arduino.h>
+#include "PWM.h"
+#include "PWM_control.h"
+#include "PWM_svpwm.h"
+#include "PWM_power.h"
+
+#define TACH_PORTB  0
+#define TACH_PORTC  1
+#define TACH_PORTD  2
+
+static PWM_CONTROL *channels[PWM_CONTROL_MAX];
+static uint8_t numChannels = 0;
+
+// Last state of every port, to find which pins changed
+static uint8_t lastPort[3];
+
+uint8_t PWM_controlDivider = 0;
+uint8_t PWM_controlCount = 0;
+
+PWM_LOG PWM_controlAdd(PWM_CONTROL *ctrl){
+    if(numChannels >= PWM_CONTROL_MAX)
+        return UNDEFINED_PWM_VALUE;
+
+    switch(ctrl->pin){
+        case _3:
+        case _5:
+        case _6:
+        case _9:
+        case _10:
+        case _11:
+            break;
+        default:
+            return INVALID_PWM_PIN;
+    }
+
+    // Uno pins: D0-D7 are PORTD, D8-D13 are PORTB and A0-A5 (14-19) are PORTC
+    uint8_t tach = ctrl->tachPin;
+    if(tach < 8){
+        ctrl->tachPort = TACH_PORTD;
+        ctrl->tachMask = _BV(tach);
+    } else if(tach < 14){
+        ctrl->tachPort = TACH_PORTB;
+        ctrl->tachMask = _BV(tach - 8);
+    } else if(tach < 20){
+        ctrl->tachPort = TACH_PORTC;
+        ctrl->tachMask = _BV(tach - 14);
+    } else {
+        return INVALID_PWM_PIN;
+    }
+
+    pinMode(tach, INPUT_PULLUP);
+    ctrl->edges = 0;
+    ctrl->integral = 0;
+    ctrl->measured = 0;
+    ctrl->output = 0;
+
+    uint8_t oldSREG = SREG;
+    cli();
+    channels[numChannels++] = ctrl;
+    switch(ctrl->tachPort){
+        case TACH_PORTB:
+            lastPort[TACH_PORTB] = PINB;
+            PCMSK0 |= ctrl->tachMask;
+            PCICR |= _BV(PCIE0);
+            break;
+        case TACH_PORTC:
+            lastPort[TACH_PORTC] = PINC;
+            PCMSK1 |= ctrl->tachMask;
+            PCICR |= _BV(PCIE1);
+            break;
+        default:
+            lastPort[TACH_PORTD] = PIND;
+            PCMSK2 |= ctrl->tachMask;
+            PCICR |= _BV(PCIE2);
+            break;
+    }
+    SREG = oldSREG;
+
+    return NO_PWM_ERROR;
+}
+
+PWM_LOG PWM_controlBegin(uint8_t divider){
+    // Timer1 belongs to the space vector PWM, see PWM_svpwm.h
+    if(divider && PWM_svpwmOn)
+        return UNDEFINED_PWM_VALUE;
+
+    // Nothing would run the loop if a hook took the vector over without it
+    #if defined(PWM_USER_TIMER1_OVF) && !defined(PWM_HOOK_CONTROL)
+        if(divider)
+            return UNDEFINED_PWM_VALUE;
+    #endif
+
+    PWM_powerOn(_9); // The loop runs from Timer1
+    uint8_t oldSREG = SREG;
+    cli();
+    PWM_controlDivider = divider;
+    PWM_controlCount = 0;
+    if(divider)
+        TIMSK1 |= _BV(TOIE1);
+    else if(!PWM_svpwmDivider && !(PWM_sharedIrq & _BV(PWM_SHARED_TIMER1_OVF)))
+        TIMSK1 &= ~(_BV(TOIE1)); // Nothing else needs it, so Timer1 can be shut down
+    SREG = oldSREG;
+    PWM_powerUpdate(_9, false);
+
+    return NO_PWM_ERROR;
+}
+
+void PWM_controlSetpoint(PWM_CONTROL *ctrl, uint16_t setpoint){
+    uint8_t oldSREG = SREG;
+    cli();
+    ctrl->setpoint = setpoint;
+    SREG = oldSREG;
+}
+
+void PWM_controlRun(void){
+    for(uint8_t i = 0; i < numChannels; i++){
+        PWM_CONTROL *ctrl = channels[i];
+
+        // Already inside an ISR, so edges can't change while it's read
+        uint16_t measured = (uint16_t)ctrl->edges << 8;
+        ctrl->edges = 0;
+
+        int32_t error = (int32_t)ctrl->setpoint - measured;
+        if(error > 32767)
+            error = 32767;
+        else if(error < -32767)
+            error = -32767;
+
+        // Everything below is in OCR counts, Q8.8
+        int32_t limit = (int32_t)ctrl->outMax << 8;
+        int32_t p = ((int32_t)ctrl->kp * error) >> 8;
+        int32_t d = ((int32_t)ctrl->kd * ((int32_t)ctrl->measured - measured)) >> 8;
+        int32_t integral = ctrl->integral + (((int32_t)ctrl->ki * error) >> 8);
+
+        // Anti-windup: keep the integral inside the output range and
+        // don't let it grow while the output is already saturated
+        if(integral > limit)
+            integral = limit;
+        else if(integral < 0)
+            integral = 0;
+
+        int32_t out = p + integral + d;
+        if(out > limit){
+            out = limit;
+            if(error < 0)
+                ctrl->integral = integral;
+        } else if(out < 0){
+            out = 0;
+            if(error > 0)
+                ctrl->integral = integral;
+        } else {
+            ctrl->integral = integral;
+        }
+
+        ctrl->measured = measured;
+        ctrl->output = (uint16_t)(out >> 8);
+        setCompareValue(ctrl->pin, ctrl->output);
+    }
+}
+
+// Counts the rising edges of every tach pin on a port
+static inline void countEdges(uint8_t port, uint8_t now){
+    uint8_t rising = (now ^ lastPort[port]) & now;
+    lastPort[port] = now;
+    if(!rising)
+        return;
+    for(uint8_t i = 0; i < numChannels; i++){
+        if((channels[i]->tachPort == port) && (rising & channels[i]->tachMask))
+            channels[i]->edges++;
+    }
+}
+
+void PWM_controlPinChange(void){
+    countEdges(TACH_PORTB, PINB);
+    countEdges(TACH_PORTC, PINC);
+    countEdges(TACH_PORTD, PIND);
+}
+
+// A weak ISR would lose to the weak __bad_interrupt the AVR startup code
+// puts in every vector, so they are left out with a define instead
+#ifndef PWM_USER_PCINT
+ISR(PCINT0_vect){
+    countEdges(TACH_PORTB, PINB);
+}
+
+ISR(PCINT1_vect){
+    countEdges(TACH_PORTC, PINC);
+}
+
+ISR(PCINT2_vect){
+    countEdges(TACH_PORTD, PIND);
+}
+#endif
+
+// A hook from PWM_hooks.h takes this over with PWM_USER_TIMER1_OVF. Only
+// one of the two is ever on, since PWM_svpwmBegin() stops the control loop.
+#ifndef PWM_USER_TIMER1_OVF
+ISR(TIMER1_OVF_vect){
+    PWM_svpwmTick();
+    PWM_controlTick();
+}
+#endif
+
+#endif /*BOARD*/
@@ -0,0 +1,145 @@
+/**
+ *
+ */
+#include "board_type.h"
+
+#if BOARD == _UNO
+
+#include <Arduino.h>
+#include "PWM.h"
+#include "PWM_dither.h"
+#include "PWM_power.h"
+
+volatile PWM_DITHER_CHANNEL PWM_ditherChannel[4];
+
+static int8_t ditherIndex(PWM_PIN pin){
+    switch(pin){
+        case _3:  return PWM_DITHER_3;
+        case _11: return PWM_DITHER_11;
+        case _5:  return PWM_DITHER_5;
+        case _6:  return PWM_DITHER_6;
+        default:  return -1;
+    }
+}
+
+// Checks the timer is in a mode where dithering the pin changes its duty cycle
+static bool ditherMode(int8_t i){
+    uint8_t wgm;
+    if(i >= PWM_DITHER_5)
+        wgm = ((TCCR0B & _BV(WGM02)) >> 1) | (TCCR0A & (_BV(WGM01) | _BV(WGM00)));
+    else
+        wgm = ((TCCR2B & _BV(WGM22)) >> 1) | (TCCR2A & (_BV(WGM21) | _BV(WGM20)));
+
+    switch(wgm){
+        case 3: // Fast PWM, TOP 0xFF
+            return true;
+        case 7: // Fast PWM, TOP OCRA, so only the B pins can be dithered
+            return (i == PWM_DITHER_3) || (i == PWM_DITHER_5);
+        case 1: // Phase correct PWM, TOP 0xFF
+            return (i < PWM_DITHER_5);
+        case 5: // Phase correct PWM, TOP OCRA
+            return (i == PWM_DITHER_3);
+        default: // Not a PWM mode
+            return false;
+    }
+}
+
+PWM_LOG setDitheredDuty(PWM_PIN pin, uint16_t value){
+    int8_t i = ditherIndex(pin);
+    if(i < 0)
+        return INVALID_PWM_PIN;
+
+    // Nothing would run the dither work if a hook took the vector over
+    // without it
+    #if defined(PWM_USER_TIMER2_OVF) && !defined(PWM_HOOK_DITHER)
+        if(i < PWM_DITHER_5)
+            return UNDEFINED_PWM_VALUE;
+    #endif
+    #if defined(PWM_USER_TIMER0_COMPA) && !defined(PWM_HOOK_DITHER)
+        if(i >= PWM_DITHER_5)
+            return UNDEFINED_PWM_VALUE;
+    #endif
+
+    // A shut down timer can't be read or written
+    PWM_powerOn(pin);
+
+    // Timer0 uses compare match A, which only happens once a period in
+    // fast PWM. On both timers OCRnA can't be dithered when it is TOP.
+    if(!ditherMode(i)){
+        PWM_powerUpdate(pin, false);
+        return UNDEFINED_PWM_VALUE;
+    }
+
+    uint8_t whole = value >> 8;
+    // There is nothing above 255 to carry into
+    uint8_t fraction = (whole == 0xFF) ? 0 : (uint8_t)value;
+
+    uint8_t oldSREG = SREG;
+    cli();
+    PWM_ditherChannel[i].whole = whole;
+    PWM_ditherChannel[i].fraction = fraction;
+    PWM_ditherChannel[i].enabled = true;
+    if(i >= PWM_DITHER_5)
+        TIMSK0 |= (_BV(OCIE0A));
+    else
+        TIMSK2 |= (_BV(TOIE2));
+    SREG = oldSREG;
+
+    return NO_PWM_ERROR;
+}
+
+PWM_LOG stopDither(PWM_PIN pin){
+    int8_t i = ditherIndex(pin);
+    if(i < 0)
+        return INVALID_PWM_PIN;
+
+    uint8_t oldSREG = SREG;
+    cli();
+    PWM_ditherChannel[i].enabled = false;
+    PWM_ditherChannel[i].error = 0;
+    if(!PWM_ditherChannel[PWM_DITHER_5].enabled && !PWM_ditherChannel[PWM_DITHER_6].enabled &&
+       !(PWM_sharedIrq & _BV(PWM_SHARED_TIMER0_COMPA)))
+        TIMSK0 &= ~(_BV(OCIE0A));
+    if(!PWM_ditherChannel[PWM_DITHER_3].enabled && !PWM_ditherChannel[PWM_DITHER_11].enabled &&
+       !(PWM_sharedIrq & _BV(PWM_SHARED_TIMER2_OVF)))
+        TIMSK2 &= ~(_BV(TOIE2));
+    SREG = oldSREG;
+
+    PWM_powerOn(pin);
+    switch(pin){
+        case _3:
+            OCR2B = PWM_ditherChannel[i].whole;
+            break;
+        case _11:
+            OCR2A = PWM_ditherChannel[i].whole;
+            break;
+        case _5:
+            OCR0B = PWM_ditherChannel[i].whole;
+            break;
+        case _6:
+            OCR0A = PWM_ditherChannel[i].whole;
+            break;
+        default:
+            break;
+    }
+    PWM_powerUpdate(pin, false); // Shut down again if nothing uses it
+    return NO_PWM_ERROR;
+}
+
+// OCR2x is double buffered, so the new value is used from the next period.
+// A weak ISR would lose to the weak __bad_interrupt the AVR startup code
+// puts in every vector, so a hook from PWM_hooks.h takes one over with
+// PWM_USER_TIMER2_OVF or PWM_USER_TIMER0_COMPA instead.
+#ifndef PWM_USER_TIMER2_OVF
+ISR(TIMER2_OVF_vect){
+    PWM_ditherTimer2();
+}
+#endif
+
+#ifndef PWM_USER_TIMER0_COMPA
+ISR(TIMER0_COMPA_vect){
+    PWM_ditherTimer0();
+}
+#endif
+
+#endif /*BOARD*/
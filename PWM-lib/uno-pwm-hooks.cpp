@@ -0,0 +1,99 @@
+/**
+ *
+ */
+#include "board_type.h"
+
+#if BOARD == _UNO
+
+#include <Arduino.h>
+#include "PWM.h"
+#include "PWM_dither.h"
+#include "PWM_control.h"
+#include "PWM_svpwm.h"
+#include "PWM_hooks.h"
+#include "PWM_power.h"
+
+// Sets or clears an interrupt enable bit without an ISR changing it in between
+static void setInterrupt(volatile uint8_t *timsk, uint8_t bit, bool on){
+    uint8_t oldSREG = SREG;
+    cli();
+    if(on)
+        *timsk |= _BV(bit);
+    else
+        *timsk &= ~(_BV(bit));
+    SREG = oldSREG;
+}
+
+// Lets the library know a hook is using one of its interrupts
+static void setShared(uint8_t bit, bool on){
+    uint8_t oldSREG = SREG;
+    cli();
+    if(on)
+        PWM_sharedIrq |= _BV(bit);
+    else
+        PWM_sharedIrq &= ~(_BV(bit));
+    SREG = oldSREG;
+}
+
+static PWM_LOG changeHook(PWM_PIN pin, PWM_HOOK hook, bool on){
+    bool timer0Dither = PWM_ditherChannel[PWM_DITHER_5].enabled ||
+                        PWM_ditherChannel[PWM_DITHER_6].enabled;
+    bool timer2Dither = PWM_ditherChannel[PWM_DITHER_3].enabled ||
+                        PWM_ditherChannel[PWM_DITHER_11].enabled;
+
+    PWM_powerOn(pin);
+    if(hook == PWM_HOOK_OVERFLOW){
+        switch(pin){
+            case _3:
+            case _11:
+                setShared(PWM_SHARED_TIMER2_OVF, on);
+                setInterrupt(&TIMSK2, TOIE2, on || timer2Dither);
+                break;
+            case _9:
+            case _10:
+                setShared(PWM_SHARED_TIMER1_OVF, on);
+                setInterrupt(&TIMSK1, TOIE1, on || PWM_controlDivider || PWM_svpwmDivider);
+                break;
+            default: // The Timer0 overflow belongs to millis()
+                return INVALID_PWM_PIN;
+        }
+        return NO_PWM_ERROR;
+    }
+
+    switch(pin){
+        case _3:
+            setInterrupt(&TIMSK2, OCIE2B, on);
+            break;
+        case _5:
+            setInterrupt(&TIMSK0, OCIE0B, on);
+            break;
+        case _6:
+            setShared(PWM_SHARED_TIMER0_COMPA, on);
+            setInterrupt(&TIMSK0, OCIE0A, on || timer0Dither);
+            break;
+        case _9:
+            setInterrupt(&TIMSK1, OCIE1A, on);
+            break;
+        case _10:
+            setInterrupt(&TIMSK1, OCIE1B, on);
+            break;
+        case _11:
+            setInterrupt(&TIMSK2, OCIE2A, on);
+            break;
+        default:
+            return INVALID_PWM_PIN;
+    }
+    return NO_PWM_ERROR;
+}
+
+PWM_LOG enableHook(PWM_PIN pin, PWM_HOOK hook){
+    return changeHook(pin, hook, true);
+}
+
+PWM_LOG disableHook(PWM_PIN pin, PWM_HOOK hook){
+    PWM_LOG eFlag = changeHook(pin, hook, false);
+    PWM_powerUpdate(pin, false); // Shut down again if nothing uses it
+    return eFlag;
+}
+
+#endif /*BOARD*/
@@ -0,0 +1,299 @@
+/**
+ *
+ */
+#include "board_type.h"
+
+#if BOARD == _UNO
+
+#include <Arduino.h>
+#include "PWM.h"
+#include "PWM_measure.h"
+#include "PWM_power.h"
+
+// Frequencies at or above this (in 1/100 Hz) are timed with no prescaler,
+// anything slower uses a prescaler of 8 so a period still fits in 16 bits
+#define MEASURE_FAST_FREQ   49000UL
+
+// Timer1 settings that get put back once the measurement is finished
+static uint8_t savedTCCR1A;
+static uint8_t savedTCCR1B;
+static uint8_t savedTIMSK1;
+
+static volatile bool measuring = false;
+static volatile bool complete = false;
+static volatile bool overrun = false;
+static volatile uint8_t numPeriods = 0;
+static volatile uint16_t lastRise = 0;
+static volatile uint32_t highSum = 0;
+static volatile uint32_t periodSum = 0;
+static uint8_t numOverflows = 0;
+static uint8_t prescaler = 1;
+
+uint32_t PWM_freqToCentiHz(PWM_FREQUENCY freq){
+    switch(freq){
+        case _62500_0Hz:  return 6250000UL;
+        case _31372_55Hz: return 3137255UL;
+        case _7812_5Hz:   return 781250UL;
+        case _3921_16Hz:  return 392116UL;
+        case _980_39Hz:   return 98039UL;
+        case _976_56Hz:   return 97656UL;
+        case _490_2Hz:    return 49020UL;
+        case _245_1Hz:    return 24510UL;
+        case _244_14Hz:   return 24414UL;
+        case _122_55Hz:   return 12255UL;
+        case _61_04Hz:    return 6104UL;
+        case _30_64Hz:    return 3064UL;
+        case _0Hz:
+        default:
+            return 0;
+    }
+}
+
+// Clock divider given by the CS bits of each timer, 0 for stopped or external
+static const uint16_t timer01Prescaler[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+static const uint16_t timer2Prescaler[8]  = { 0, 1, 8, 32, 64, 128, 256, 1024 };
+
+// Timer clocks in one period of an 8-bit timer (Timer0 or Timer2)
+static uint32_t ticks8(uint8_t wgm, uint8_t ocra){
+    switch(wgm){
+        case 1:  return 510UL;                      // Phase correct, TOP 0xFF
+        case 3:  return 256UL;                      // Fast, TOP 0xFF
+        case 5:  return 2UL * ocra;                 // Phase correct, TOP OCRA
+        case 7:  return (uint32_t)ocra + 1;         // Fast, TOP OCRA
+        default: return 0;                          // Not a PWM mode
+    }
+}
+
+// Timer clocks in one period of Timer1
+static uint32_t ticks16(uint8_t wgm){
+    switch(wgm){
+        case 1:  return 510UL;
+        case 2:  return 1022UL;
+        case 3:  return 2046UL;
+        case 5:  return 256UL;
+        case 6:  return 512UL;
+        case 7:  return 1024UL;
+        case 8:
+        case 10: return 2UL * ICR1;
+        case 9:
+        case 11: return 2UL * OCR1A;
+        case 14: return (uint32_t)ICR1 + 1;
+        case 15: return (uint32_t)OCR1A + 1;
+        default: return 0;
+    }
+}
+
+uint32_t PWM_pinFreq(PWM_PIN pin){
+    uint32_t ticks;
+    uint16_t div;
+    switch(pin){
+        case _3:
+        case _11:
+            ticks = ticks8(((TCCR2B & _BV(WGM22)) >> 1) | (TCCR2A & (_BV(WGM21) | _BV(WGM20))), OCR2A);
+            div = timer2Prescaler[TCCR2B & (_BV(CS22) | _BV(CS21) | _BV(CS20))];
+            break;
+        case _5:
+        case _6:
+            ticks = ticks8(((TCCR0B & _BV(WGM02)) >> 1) | (TCCR0A & (_BV(WGM01) | _BV(WGM00))), OCR0A);
+            div = timer01Prescaler[TCCR0B & (_BV(CS02) | _BV(CS01) | _BV(CS00))];
+            break;
+        case _9:
+        case _10:
+            ticks = ticks16(((TCCR1B & (_BV(WGM13) | _BV(WGM12))) >> 1) | (TCCR1A & (_BV(WGM11) | _BV(WGM10))));
+            div = timer01Prescaler[TCCR1B & (_BV(CS12) | _BV(CS11) | _BV(CS10))];
+            break;
+        default:
+            return 0;
+    }
+    if((ticks == 0) || (div == 0))
+        return 0;
+    ticks *= div;
+    return ((F_CPU * 100UL) + (ticks / 2)) / ticks;
+}
+
+// The expected duty cycle in 1/100 % as it will be seen on the pin
+static uint16_t expectedDuty(PWM_SIG *pwm){
+    uint16_t duty = pwm->dutyCycle * 100;
+    if(pwm->output == PWM_INVERTED)
+        duty = 10000 - duty;
+    return duty;
+}
+
+PWM_LOG PWM_measureStart(PWM_SIG *pwm){
+    if((pwm->pin == _9) || (pwm->pin == _10))
+        return INVALID_PWM_PIN; // Timer1 can't time itself
+
+    uint32_t freq = PWM_pinFreq(pwm->pin);
+    if(freq == 0)
+        return INVALID_PWM_FREQ;
+
+    pinMode(8, INPUT); // ICP1
+    PWM_powerOn(_9);
+
+    uint8_t oldSREG = SREG;
+    cli();
+    savedTCCR1A = TCCR1A;
+    savedTCCR1B = TCCR1B;
+    savedTIMSK1 = TIMSK1;
+
+    measuring = true;
+    complete = false;
+    overrun = false;
+    numPeriods = 0;
+    highSum = 0;
+    periodSum = 0;
+    numOverflows = 0;
+    prescaler = (freq >= MEASURE_FAST_FREQ) ? 1 : 8;
+
+    // Normal mode, capture on the rising edge first
+    TCCR1A = 0;
+    TCCR1B = _BV(ICES1) | ((prescaler == 1) ? _BV(CS10) : _BV(CS11));
+    TIFR1 = _BV(ICF1) | _BV(TOV1);
+    TIMSK1 = _BV(ICIE1);
+    SREG = oldSREG;
+
+    return NO_PWM_ERROR;
+}
+
+bool PWM_measureDone(void){
+    if(!measuring)
+        return true;
+
+    // The overflow flag is only polled so the capture interrupt
+    // is the only interrupt the measurement needs
+    if(TIFR1 & _BV(TOV1)){
+        TIFR1 = _BV(TOV1);
+        if(++numOverflows >= (2 * PWM_MEASURE_BATCH + 4)){
+            TIMSK1 &= ~(_BV(ICIE1));
+            measuring = false;
+        }
+    }
+    return !measuring;
+}
+
+PWM_LOG PWM_measureResult(PWM_SIG *pwm, PWM_MEASUREMENT *result){
+    uint32_t expected = PWM_pinFreq(pwm->pin);
+    uint8_t oldSREG = SREG;
+    cli();
+    TCCR1A = savedTCCR1A;
+    TCCR1B = savedTCCR1B;
+    TIMSK1 = savedTIMSK1;
+    SREG = oldSREG;
+
+    if(overrun)
+        return PWM_MEASURE_OVERRUN;
+    if(!complete)
+        return PWM_MEASURE_TIMEOUT;
+
+    uint32_t period = periodSum;
+    uint32_t high = highSum;
+
+    // frequency = (clock / period) * batch, split into quotient and
+    // remainder so neither step overflows 32 bits
+    uint32_t clock = (F_CPU / prescaler) * 100UL;
+    uint32_t q = clock / period;
+    uint32_t r = clock % period;
+    result->frequency = (q * PWM_MEASURE_BATCH) + ((r * PWM_MEASURE_BATCH) / period);
+
+    // Scale down until high * 10000 fits in 32 bits
+    while(period >= (0xFFFFFFFFUL / 10000UL)){
+        period >>= 1;
+        high >>= 1;
+    }
+    result->dutyCycle = (uint16_t)((high * 10000UL) / period);
+
+    result->freqError = (int32_t)result->frequency - (int32_t)expected;
+    result->dutyError = (int16_t)result->dutyCycle - (int16_t)expectedDuty(pwm);
+
+    return NO_PWM_ERROR;
+}
+
+PWM_LOG PWM_measure(PWM_SIG *pwm, PWM_MEASUREMENT *result){
+    PWM_LOG eFlag = PWM_measureStart(pwm);
+    if(eFlag != NO_PWM_ERROR)
+        return eFlag;
+
+    while(!PWM_measureDone());
+
+    return PWM_measureResult(pwm, result);
+}
+
+PWM_LOG PWM_verify(PWM_SIG *pwm, PWM_MEASUREMENT *result){
+    uint16_t duty = expectedDuty(pwm);
+
+    // No edges to time, so just make sure the pin is stuck at the right level
+    if((duty == 0) || (duty == 10000)){
+        bool high = (PINB & _BV(PINB0)) != 0;
+        result->frequency = 0;
+        result->freqError = 0;
+        result->dutyCycle = high ? 10000 : 0;
+        result->dutyError = (int16_t)result->dutyCycle - (int16_t)duty;
+        return (result->dutyError == 0) ? NO_PWM_ERROR : INVALID_PWM_DUTY_CYCLE_VALUE;
+    }
+
+    PWM_LOG eFlag = PWM_measure(pwm, result);
+    if(eFlag != NO_PWM_ERROR)
+        return eFlag;
+
+    int32_t freqTol = (int32_t)((PWM_pinFreq(pwm->pin) * PWM_VERIFY_FREQ_TOL) / 1000UL);
+    if((result->freqError > freqTol) || (result->freqError < -freqTol))
+        return INVALID_PWM_FREQ;
+
+    if((result->dutyError > PWM_VERIFY_DUTY_TOL) || (result->dutyError < -PWM_VERIFY_DUTY_TOL))
+        return INVALID_PWM_DUTY_CYCLE_VALUE;
+
+    return NO_PWM_ERROR;
+}
+
+// Every edge is timestamped by the hardware in ICR1, so only the
+// differences between the timestamps are needed. A single period
+// always fits in 16 bits thanks to the prescaler picked in
+// PWM_measureStart(), so the subtraction wraps around correctly.
+static inline void captureEdge(void) __attribute__((always_inline));
+static inline void captureEdge(void){
+    uint16_t stamp = ICR1;
+    bool wasRising = TCCR1B & _BV(ICES1);
+
+    if(wasRising){
+        if(numPeriods > 0)
+            periodSum += (uint16_t)(stamp - lastRise);
+        lastRise = stamp;
+        if(numPeriods == PWM_MEASURE_BATCH){
+            TIMSK1 &= ~(_BV(ICIE1));
+            complete = true;
+            measuring = false;
+            return;
+        }
+        numPeriods++;
+        TCCR1B &= ~(_BV(ICES1));
+    } else {
+        highSum += (uint16_t)(stamp - lastRise);
+        TCCR1B |= _BV(ICES1);
+    }
+    // Changing the edge can set the flag, so it has to be cleared
+    TIFR1 = _BV(ICF1);
+
+    // If the pin has already passed the next edge and the flag wasn't
+    // set after it was cleared, then that edge happened too soon to be
+    // captured and the result can't be trusted
+    bool pinHigh = PINB & _BV(PINB0);
+    if((pinHigh != wasRising) && !(TIFR1 & _BV(ICF1))){
+        TIMSK1 &= ~(_BV(ICIE1));
+        overrun = true;
+        measuring = false;
+    }
+}
+
+void PWM_measureCapture(void){
+    captureEdge();
+}
+
+// A weak ISR would lose to the weak __bad_interrupt the AVR startup
+// code puts in every vector, so it is left out with a define instead
+#ifndef PWM_USER_TIMER1_CAPT
+ISR(TIMER1_CAPT_vect){
+    captureEdge();
+}
+#endif
+
+#endif /*BOARD*/
@@ -0,0 +1,115 @@
+/**
+ *
+ */
+#include "board_type.h"
+
+#if BOARD == _UNO
+
+#include <Arduino.h>
+#include <avr/sleep.h>
+#include "PWM.h"
+#include "PWM_power.h"
+
+// Output compare bits of both pins of each timer
+#define TIMER0_COM  (_BV(COM0A1) | _BV(COM0A0) | _BV(COM0B1) | _BV(COM0B0))
+#define TIMER1_COM  (_BV(COM1A1) | _BV(COM1A0) | _BV(COM1B1) | _BV(COM1B0))
+#define TIMER2_COM  (_BV(COM2A1) | _BV(COM2A0) | _BV(COM2B1) | _BV(COM2B0))
+
+// Datasheet current of each timer in 1/10 uA at 8 MHz, see PWM_power.h
+#define TIMER0_CURRENT  322UL
+#define TIMER1_CURRENT  954UL
+#define TIMER2_CURRENT  1112UL
+
+// Gives the PRR bit of a pin's timer, 0 for pins without one
+static uint8_t timerBit(PWM_PIN pin){
+    switch(pin){
+        case _3:
+        case _11:
+            return _BV(PRTIM2);
+        case _5:
+        case _6:
+            return _BV(PRTIM0);
+        case _9:
+        case _10:
+            return _BV(PRTIM1);
+        default:
+            return 0;
+    }
+}
+
+void PWM_powerOn(PWM_PIN pin){
+    uint8_t bit = timerBit(pin);
+    if(PRR & bit){
+        uint8_t oldSREG = SREG;
+        cli();
+        PRR &= ~bit;
+        SREG = oldSREG;
+    }
+}
+
+void PWM_powerUpdate(PWM_PIN pin, bool active){
+    if(active){
+        PWM_powerOn(pin);
+        return;
+    }
+
+    // The registers are read instead of remembering what was enabled, so
+    // outputs turned on some other way (like analogWrite() while the
+    // timer was on) are seen too.
+    // A timer with an interrupt on is still being used for something
+    // (dithering, hooks, the control loop or a measurement).
+    uint8_t gate = 0;
+    if(!(TCCR1A & TIMER1_COM) && (TIMSK1 == 0))
+        gate |= _BV(PRTIM1);
+    if(!(TCCR2A & TIMER2_COM) && (TIMSK2 == 0))
+        gate |= _BV(PRTIM2);
+    #ifdef PWM_GATE_TIMER0
+        // The millis() interrupt is always on, so it doesn't count here
+        if(!(TCCR0A & TIMER0_COM) && ((TIMSK0 & ~(_BV(TOIE0))) == 0))
+            gate |= _BV(PRTIM0);
+    #endif
+
+    gate &= timerBit(pin);
+    if(gate){
+        uint8_t oldSREG = SREG;
+        cli();
+        PRR |= gate;
+        SREG = oldSREG;
+    }
+}
+
+uint8_t PWM_sleepMode(void){
+    bool run0 = !(PRR & _BV(PRTIM0)) && (TCCR0B & (_BV(CS02) | _BV(CS01) | _BV(CS00)));
+    bool run1 = !(PRR & _BV(PRTIM1)) && (TCCR1B & (_BV(CS12) | _BV(CS11) | _BV(CS10)));
+    bool run2 = !(PRR & _BV(PRTIM2)) && (TCCR2B & (_BV(CS22) | _BV(CS21) | _BV(CS20)));
+    bool async2 = ASSR & _BV(AS2);
+
+    if(run0 || run1 || (run2 && !async2))
+        return SLEEP_MODE_IDLE;
+    if(run2)
+        return SLEEP_MODE_PWR_SAVE;
+    return SLEEP_MODE_PWR_DOWN;
+}
+
+void PWM_sleep(void){
+    set_sleep_mode(PWM_sleepMode());
+    cli();
+    sleep_enable();
+    sei();
+    sleep_cpu();
+    sleep_disable();
+}
+
+uint16_t PWM_powerSaved(void){
+    uint32_t current = 0;
+    if(PRR & _BV(PRTIM0))
+        current += TIMER0_CURRENT;
+    if(PRR & _BV(PRTIM1))
+        current += TIMER1_CURRENT;
+    if(PRR & _BV(PRTIM2))
+        current += TIMER2_CURRENT;
+    // The table is at 8 MHz and in 1/10 uA
+    return (uint16_t)((current * (F_CPU / 1000000UL)) / 80UL);
+}
+
+#endif /*BOARD*/
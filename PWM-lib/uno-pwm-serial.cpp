@@ -0,0 +1,187 @@
+/**
+ *
+ */
+#include "board_type.h"
+
+#if BOARD == _UNO
+
+#include <Arduino.h>
+#include <util/crc16.h>
+#include "PWM.h"
+#include "PWM_serial.h"
+
+// Header (sync, length, sequence) and CRC around the updates
+#define FRAME_HEADER    3
+#define FRAME_CRC       2
+#define FRAME_MAX       (FRAME_HEADER + (PWM_SERIAL_MAX_UPDATES * PWM_UPDATE_SIZE) + FRAME_CRC)
+
+// Bytes are copied here from the serial receive buffer, and the frame
+// is checked and applied from here
+static uint8_t rxFrame[FRAME_MAX];
+static uint8_t rxCount = 0;
+static uint32_t lastByte = 0;
+
+uint16_t PWM_crc16(const uint8_t *data, uint8_t length){
+    uint16_t crc = 0xFFFF;
+    for(uint8_t i = 0; i < length; i++)
+        crc = _crc_xmodem_update(crc, data[i]);
+    return crc;
+}
+
+static PWM_LOG checkUpdate(const uint8_t *update){
+    switch((PWM_PIN)update[0]){
+        case _3:
+        case _5:
+        case _6:
+        case _9:
+        case _10:
+        case _11:
+            break;
+        default:
+            return INVALID_PWM_PIN;
+    }
+
+    uint16_t value = update[2] | ((uint16_t)update[3] << 8);
+    switch(update[1]){
+        case PWM_FIELD_FREQUENCY:
+            // Not every timer can make every frequency
+            return (value <= _30_64Hz) ? checkFreq((PWM_PIN)update[0], (PWM_FREQUENCY)value) :
+                   INVALID_PWM_FREQ;
+        case PWM_FIELD_MODE:
+            return (value <= PWM_CLEAR_TIMER_ON_COMP) ? NO_PWM_ERROR : UNDEFINED_PWM_VALUE;
+        case PWM_FIELD_ADV_MODE:
+            return (((value >> 8) <= PWM_CLEAR_TIMER_ON_COMP) && ((value & 0xFF) <= PWM_OCR1A)) ?
+                   NO_PWM_ERROR : UNDEFINED_PWM_VALUE;
+        case PWM_FIELD_OUTPUT:
+            return (value <= PWM_INVERTED) ? NO_PWM_ERROR : UNDEFINED_PWM_VALUE;
+        case PWM_FIELD_DUTY:
+            return (value <= 100) ? NO_PWM_ERROR : INVALID_PWM_DUTY_CYCLE_VALUE;
+        case PWM_FIELD_COMPARE:
+            return NO_PWM_ERROR;
+        default:
+            return UNDEFINED_PWM_VALUE;
+    }
+}
+
+// The setters keep the pin's PWM_SIG up to date themselves
+static PWM_LOG applyUpdate(const uint8_t *update){
+    PWM_PIN pin = (PWM_PIN)update[0];
+    uint16_t value = update[2] | ((uint16_t)update[3] << 8);
+
+    switch(update[1]){
+        case PWM_FIELD_FREQUENCY:
+            return setFreq(pin, (PWM_FREQUENCY)value);
+        case PWM_FIELD_MODE:
+            setMode(pin, (PWM_MODE)value);
+            return NO_PWM_ERROR;
+        case PWM_FIELD_ADV_MODE:
+            setAdvancedMode(pin, (PWM_MODE)(value >> 8), (PWM_ADV_MODE)(value & 0xFF));
+            return NO_PWM_ERROR;
+        case PWM_FIELD_OUTPUT:
+            setOutputType(pin, (PWM_OUTPUT)value);
+            return NO_PWM_ERROR;
+        case PWM_FIELD_DUTY:
+            return setDutyCycle(pin, value);
+        case PWM_FIELD_COMPARE:
+            return setCompareValue(pin, value);
+        default:
+            return UNDEFINED_PWM_VALUE;
+    }
+}
+
+PWM_LOG PWM_applyFrame(const uint8_t *updates, uint8_t length, uint8_t *index){
+    PWM_LOG eFlag = NO_PWM_ERROR;
+    uint8_t count = length / PWM_UPDATE_SIZE;
+    *index = 0xFF;
+
+    // Check everything first so a bad frame changes nothing
+    for(uint8_t i = 0; i < count; i++){
+        eFlag = checkUpdate(&updates[i * PWM_UPDATE_SIZE]);
+        if(eFlag != NO_PWM_ERROR){
+            *index = i;
+            return eFlag;
+        }
+    }
+
+    uint8_t oldSREG = SREG;
+    cli();
+    for(uint8_t i = 0; i < count; i++){
+        // Stop at the first update the setter turns down
+        eFlag = applyUpdate(&updates[i * PWM_UPDATE_SIZE]);
+        if(eFlag != NO_PWM_ERROR){
+            *index = i;
+            break;
+        }
+    }
+    SREG = oldSREG;
+
+    return eFlag;
+}
+
+static void sendAck(Stream &port, uint8_t seq, PWM_LOG status, uint8_t index){
+    uint8_t ack[6];
+    ack[0] = PWM_ACK_SYNC;
+    ack[1] = seq;
+    ack[2] = (uint8_t)status;
+    ack[3] = index;
+    uint16_t crc = PWM_crc16(&ack[1], 3);
+    ack[4] = (uint8_t)crc;
+    ack[5] = (uint8_t)(crc >> 8);
+    port.write(ack, sizeof(ack));
+}
+
+bool PWM_serialPoll(Stream &port){
+    // A gap in the middle of a frame means a byte was lost, so the
+    // partial frame is dropped instead of being joined to the next one
+    if((rxCount > 0) && ((millis() - lastByte) > PWM_SERIAL_TIMEOUT_MS)){
+        bool acked = (rxCount >= FRAME_HEADER);
+        if(acked)
+            sendAck(port, rxFrame[2], INVALID_PWM_FRAME, 0xFF);
+        rxCount = 0;
+        if(acked)
+            return true;
+    }
+
+    while(port.available() > 0){
+        uint8_t byte = (uint8_t)port.read();
+        lastByte = millis();
+
+        if((rxCount == 0) && (byte != PWM_FRAME_SYNC))
+            continue; // Wait for the start of a frame
+        rxFrame[rxCount++] = byte;
+
+        if(rxCount < FRAME_HEADER)
+            continue;
+
+        uint8_t length = rxFrame[1];
+        uint8_t seq = rxFrame[2];
+        if((length == 0) || (length % PWM_UPDATE_SIZE) ||
+           (length > (PWM_SERIAL_MAX_UPDATES * PWM_UPDATE_SIZE))){
+            // Can't be a real frame, let the sender know and look for
+            // the next sync byte
+            rxCount = 0;
+            sendAck(port, seq, INVALID_PWM_FRAME, 0xFF);
+            return true;
+        }
+
+        if(rxCount < (FRAME_HEADER + length + FRAME_CRC))
+            continue;
+
+        // A whole frame is in, check and apply it right where it is
+        uint16_t crc = rxFrame[FRAME_HEADER + length] |
+                       ((uint16_t)rxFrame[FRAME_HEADER + length + 1] << 8);
+        rxCount = 0;
+
+        if(crc != PWM_crc16(&rxFrame[1], length + 2)){
+            sendAck(port, seq, INVALID_PWM_FRAME, 0xFF);
+        } else {
+            uint8_t index;
+            PWM_LOG eFlag = PWM_applyFrame(&rxFrame[FRAME_HEADER], length, &index);
+            sendAck(port, seq, eFlag, index);
+        }
+        return true;
+    }
+    return false;
+}
+
+#endif /*BOARD*/
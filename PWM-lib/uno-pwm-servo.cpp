@@ -0,0 +1,176 @@
+/**
+ *
+ */
+#include "board_type.h"
+
+#if BOARD == _UNO
+
+#include <Arduino.h>
+#include "PWM.h"
+#include "PWM_power.h"
+#include "PWM_servo.h"
+
+// Pulse limits of every protocol in 1/16 us, in the same order as PWM_SERVO_PROTOCOL
+static const uint16_t minPulse[] = { PWM_SERVO_MIN_US * 16U, 125 * 16U, 42 * 16U, 5 * 16U };
+static const uint16_t maxPulse[] = { PWM_SERVO_MAX_US * 16U, 250 * 16U, 84 * 16U, 25 * 16U };
+
+static PWM_SERVO_PROTOCOL servoProtocol = PWM_SERVO;
+
+// OneShot widths waiting for the next triggerPulse(). In normal mode
+// OCR1x isn't double buffered, so writing it during a pulse could
+// make the timer miss the match and hold the pin high until it wraps.
+static uint16_t nextTicksA = 0;
+static uint16_t nextTicksB = 0;
+
+PWM_LOG setServoMode(PWM_PIN pin, PWM_SERVO_PROTOCOL protocol, uint16_t rate){
+    if((pin != _9) && (pin != _10))
+        return INVALID_PWM_PIN;
+
+    // Counts as an enabled output, so the timer isn't shut down
+    PWM_powerUpdate(pin, true);
+
+    uint8_t oldSREG = SREG;
+    cli();
+    // Stop the timer while it's being changed
+    TCCR1B &= ~(_BV(CS12) | _BV(CS11) | _BV(CS10));
+    TCNT1 = 0;
+
+    switch(protocol){
+        case PWM_SERVO: {
+            // 0.5 us per tick with a prescaler of 8
+            uint32_t top = (rate == 0) ? 0 : ((F_CPU / 8UL) / rate) - 1;
+            if((top > 0xFFFF) || ((top + 1) < (maxPulse[PWM_SERVO] / 8U))){
+                SREG = oldSREG;
+                return INVALID_PWM_FREQ;
+            }
+            // Fast PWM with ICR1 as TOP (WGM 14)
+            ICR1 = (uint16_t)top;
+            TCCR1A &= ~(_BV(WGM10));
+            TCCR1A |= (_BV(WGM11));
+            TCCR1B |= (_BV(WGM13) | _BV(WGM12));
+            break;
+        }
+        case PWM_ONESHOT125:
+        case PWM_ONESHOT42:
+        case PWM_MULTISHOT:
+            // Normal mode, the timer is only used to time a single pulse
+            TCCR1A &= ~(_BV(WGM11) | _BV(WGM10));
+            TCCR1B &= ~(_BV(WGM13) | _BV(WGM12));
+            break;
+        default:
+            SREG = oldSREG;
+            return UNDEFINED_PWM_VALUE;
+    }
+    servoProtocol = protocol;
+
+    // Clear the output on compare match. In PWM_SERVO it gets set
+    // again at BOTTOM, in the OneShot protocols by triggerPulse()
+    if(pin == _9){
+        TCCR1A &= ~(_BV(COM1A0));
+        TCCR1A |= (_BV(COM1A1));
+    } else {
+        TCCR1A &= ~(_BV(COM1B0));
+        TCCR1A |= (_BV(COM1B1));
+    }
+
+    if(protocol == PWM_SERVO)
+        TCCR1B |= (_BV(CS11));
+    else
+        TCCR1B |= (_BV(CS10));
+    SREG = oldSREG;
+
+    pinMode(pin, OUTPUT);
+    return setPulseWidthFine(pin, minPulse[protocol]);
+}
+
+PWM_LOG setPulseWidth(PWM_PIN pin, uint16_t us){
+    if(us > (0xFFFF / 16))
+        return INVALID_PWM_PULSE_WIDTH;
+    return setPulseWidthFine(pin, us * 16);
+}
+
+PWM_LOG setPulseWidthFine(PWM_PIN pin, uint16_t sixteenths){
+    if((sixteenths < minPulse[servoProtocol]) || (sixteenths > maxPulse[servoProtocol]))
+        return INVALID_PWM_PULSE_WIDTH;
+
+    PWM_powerOn(pin); // A shut down timer ignores writes
+    uint16_t ticks;
+    if(servoProtocol == PWM_SERVO)
+        ticks = (sixteenths / 8) - 1; // Fast PWM stays high for OCR1x + 1 ticks
+    else
+        ticks = sixteenths;
+
+    if(servoProtocol != PWM_SERVO){
+        switch(pin){
+            case _9:
+                nextTicksA = ticks;
+                break;
+            case _10:
+                nextTicksB = ticks;
+                break;
+            default:
+                return INVALID_PWM_PIN;
+        }
+        return NO_PWM_ERROR;
+    }
+
+    switch(pin){
+        case _9:
+            OCR1A = ticks;
+            break;
+        case _10:
+            OCR1B = ticks;
+            break;
+        default:
+            return INVALID_PWM_PIN;
+    }
+    return NO_PWM_ERROR;
+}
+
+PWM_LOG triggerPulse(void){
+    if(servoProtocol == PWM_SERVO)
+        return UNDEFINED_PWM_VALUE;
+
+    PWM_powerOn(_9);
+    uint8_t com = TCCR1A;
+    uint8_t setCom = 0;
+    uint8_t force = 0;
+    uint8_t busy = 0;
+    if(com & _BV(COM1A1)){
+        setCom |= _BV(COM1A0);
+        force |= _BV(FOC1A);
+        busy |= _BV(PINB1);
+    }
+    if(com & _BV(COM1B1)){
+        setCom |= _BV(COM1B0);
+        force |= _BV(FOC1B);
+        busy |= _BV(PINB2);
+    }
+
+    // A pin that is still high is still sending the last pulse
+    if(PINB & busy)
+        return PWM_PULSE_BUSY;
+
+    uint8_t oldSREG = SREG;
+    cli();
+    // Stop and clear the timer first, so a match with the old count
+    // can't end the new pulse as soon as it starts
+    uint8_t clock = TCCR1B;
+    TCCR1B = clock & ~(_BV(CS12) | _BV(CS11) | _BV(CS10));
+    TCNT1 = 0;
+    OCR1A = nextTicksA;
+    OCR1B = nextTicksB;
+
+    // Force the enabled outputs high by switching them to "set on
+    // compare match" for a moment, then back to "clear on compare
+    // match" so they go low again when the timer reaches OCR1x
+    TCCR1A = com | setCom;
+    TCCR1C = force;
+    TCCR1A = com;
+    TCCR1B = clock;
+    SREG = oldSREG;
+
+    return NO_PWM_ERROR;
+}
+
+#endif /*BOARD*/
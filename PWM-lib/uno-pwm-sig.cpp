@@ -6,17 +6,102 @@
 #if BOARD == _UNO
 
 #include "PWM.h"
+#include "PWM_power.h"
 #include <Arduino.h>
 #include <stdint.h>
 
+PWM_SIG *PWM_signals[6] = { NULL, NULL, NULL, NULL, NULL, NULL };
+volatile uint8_t PWM_sharedIrq = 0;
+
+static int8_t signalIndex(PWM_PIN pin){
+    switch(pin){
+        case _3:  return PWM_CHANNEL__3;
+        case _5:  return PWM_CHANNEL__5;
+        case _6:  return PWM_CHANNEL__6;
+        case _9:  return PWM_CHANNEL__9;
+        case _10: return PWM_CHANNEL__10;
+        case _11: return PWM_CHANNEL__11;
+        default:  return -1;
+    }
+}
+
 void PWM_init(PWM_SIG *PWM){ 
+    int8_t i = signalIndex(PWM->pin);
+    if(i >= 0)
+        PWM_signals[i] = PWM;
     pinMode(PWM->pin, OUTPUT);
 }
 
+PWM_SIG *PWM_getSignal(PWM_PIN pin){
+    int8_t i = signalIndex(pin);
+    return (i >= 0) ? PWM_signals[i] : NULL;
+}
+
+PWM_SIG *PWM_getSiblingSignal(PWM_PIN pin){
+    switch(pin){
+        case _3:  return PWM_signals[PWM_CHANNEL__11];
+        case _11: return PWM_signals[PWM_CHANNEL__3];
+        case _5:  return PWM_signals[PWM_CHANNEL__6];
+        case _6:  return PWM_signals[PWM_CHANNEL__5];
+        case _9:  return PWM_signals[PWM_CHANNEL__10];
+        case _10: return PWM_signals[PWM_CHANNEL__9];
+        default:  return NULL;
+    }
+}
+
+PWM_LOG checkFreq(PWM_PIN pin, PWM_FREQUENCY freq){
+    switch(pin){
+        case _3:
+        case _11:
+            switch(freq){
+                case _31372_55Hz:
+                case _3921_16Hz:
+                case _980_39Hz:
+                case _490_2Hz:
+                case _245_1Hz:
+                case _122_55Hz:
+                case _30_64Hz:
+                    return NO_PWM_ERROR;
+                default:
+                    return INVALID_PWM_FREQ;
+            }
+        case _9:
+        case _10:
+            switch(freq){
+                case _31372_55Hz:
+                case _3921_16Hz:
+                case _490_2Hz:
+                case _122_55Hz:
+                case _30_64Hz:
+                    return NO_PWM_ERROR;
+                default:
+                    return INVALID_PWM_FREQ;
+            }
+        case _5:
+        case _6:
+            switch(freq){
+                case _62500_0Hz:
+                case _7812_5Hz:
+                case _976_56Hz:
+                case _244_14Hz:
+                case _61_04Hz:
+                    return NO_PWM_ERROR;
+                default:
+                    return INVALID_PWM_FREQ;
+            }
+        default:
+            return INVALID_PWM_PIN;
+    }
+}
+
 // The following link contains the information about the frequencies:
 //      http://arduinoinfo.mywikis.net/wiki/Arduino-PWM-Frequency
 PWM_LOG setFreq(PWM_PIN pin, PWM_FREQUENCY freq){
-    PWM_LOG eFlag = NO_PWM_ERROR;
+    // Checked first, clearing the CS bits below would stop the timer
+    PWM_LOG eFlag = checkFreq(pin, freq);
+    if(eFlag != NO_PWM_ERROR)
+        return eFlag;
+    PWM_powerOn(pin); // A shut down timer ignores writes
     switch (pin){
         case _3:
         case _11:
@@ -103,6 +188,16 @@ PWM_LOG setFreq(PWM_PIN pin, PWM_FREQUENCY freq){
             eFlag = INVALID_PWM_PIN;
             break;
     }
+    PWM_powerUpdate(pin, false); // Shut down again if nothing uses it
+
+    if(eFlag == NO_PWM_ERROR){
+        PWM_SIG *sig = PWM_getSignal(pin);
+        if(sig)
+            sig->frequency = freq;
+        sig = PWM_getSiblingSignal(pin);
+        if(sig)
+            sig->frequency = freq;
+    }
     return eFlag;
 }
 
@@ -115,6 +210,7 @@ PWM_LOG setDutyCycle(PWM_PIN pin, uint16_t percent){ // it says duty xD
         (percent <= 100) ? 
         NO_PWM_ERROR : 
         INVALID_PWM_DUTY_CYCLE_VALUE;
+    PWM_powerOn(pin);
     // This is because the PWM for pins 9 and 10 use a 16-bit timer
     uint16_t dutyCycle16 = 0;
     uint8_t dutyCycle8 = 0;
@@ -147,7 +243,42 @@ PWM_LOG setDutyCycle(PWM_PIN pin, uint16_t percent){ // it says duty xD
             eFlag = INVALID_PWM_PIN;
             break;
     }
+    PWM_powerUpdate(pin, false); // Shut down again if nothing uses it
+
+    PWM_SIG *sig = PWM_getSignal(pin);
+    if(sig && (eFlag == NO_PWM_ERROR))
+        sig->dutyCycle = percent;
+    return eFlag;
 }
 
+PWM_LOG setCompareValue(PWM_PIN pin, uint16_t value){
+    PWM_LOG eFlag = NO_PWM_ERROR;
+    PWM_powerOn(pin);
+    switch(pin){
+        case _3:
+            OCR2B = (uint8_t)value;
+            break;
+        case _5:
+            OCR0B = (uint8_t)value;
+            break;
+        case _6:
+            OCR0A = (uint8_t)value;
+            break;
+        case _9:
+            OCR1A = value;
+            break;
+        case _10:
+            OCR1B = value;
+            break;
+        case _11:
+            OCR2A = (uint8_t)value;
+            break;
+        default:
+            eFlag = INVALID_PWM_PIN;
+            break;
+    }
+    PWM_powerUpdate(pin, false); // Shut down again if nothing uses it
+    return eFlag;
+}
 
 #endif /*BOARD*/
\ No newline at end of file
@@ -0,0 +1,191 @@
+/**
+ *
+ */
+#include "board_type.h"
+
+#if BOARD == _UNO
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+#include "PWM.h"
+#include "PWM_svpwm.h"
+#include "PWM_control.h"
+#include "PWM_power.h"
+
+// sin(i * 60 / 256 degrees) in Q15, a whole sector and one more
+static const uint16_t sinTable[257] PROGMEM = {
+        0,   134,   268,   402,   536,   670,   804,   938,
+     1072,  1206,  1340,  1474,  1608,  1742,  1875,  2009,
+     2143,  2277,  2410,  2544,  2678,  2811,  2945,  3078,
+     3212,  3345,  3478,  3612,  3745,  3878,  4011,  4144,
+     4277,  4410,  4543,  4675,  4808,  4940,  5073,  5205,
+     5338,  5470,  5602,  5734,  5866,  5998,  6129,  6261,
+     6393,  6524,  6655,  6786,  6917,  7048,  7179,  7310,
+     7441,  7571,  7701,  7832,  7962,  8092,  8222,  8351,
+     8481,  8610,  8739,  8868,  8997,  9126,  9255,  9383,
+     9512,  9640,  9768,  9896, 10024, 10151, 10278, 10406,
+    10533, 10659, 10786, 10913, 11039, 11165, 11291, 11417,
+    11542, 11668, 11793, 11918, 12042, 12167, 12291, 12415,
+    12539, 12663, 12787, 12910, 13033, 13156, 13279, 13401,
+    13523, 13645, 13767, 13888, 14010, 14131, 14252, 14372,
+    14492, 14613, 14732, 14852, 14971, 15090, 15209, 15328,
+    15446, 15564, 15682, 15800, 15917, 16034, 16151, 16267,
+    16383, 16499, 16615, 16730, 16846, 16960, 17075, 17189,
+    17303, 17417, 17530, 17643, 17756, 17869, 17981, 18093,
+    18204, 18316, 18427, 18537, 18648, 18758, 18868, 18977,
+    19086, 19195, 19303, 19411, 19519, 19627, 19734, 19841,
+    19947, 20053, 20159, 20265, 20370, 20475, 20579, 20683,
+    20787, 20891, 20994, 21096, 21199, 21301, 21403, 21504,
+    21605, 21705, 21806, 21905, 22005, 22104, 22203, 22301,
+    22399, 22497, 22594, 22691, 22788, 22884, 22979, 23075,
+    23170, 23264, 23359, 23452, 23546, 23639, 23731, 23824,
+    23915, 24007, 24098, 24189, 24279, 24369, 24458, 24547,
+    24636, 24724, 24811, 24899, 24986, 25072, 25158, 25244,
+    25329, 25414, 25498, 25582, 25666, 25749, 25832, 25914,
+    25996, 26077, 26158, 26239, 26319, 26398, 26478, 26556,
+    26635, 26712, 26790, 26867, 26943, 27019, 27095, 27170,
+    27245, 27319, 27393, 27466, 27539, 27611, 27683, 27755,
+    27826, 27896, 27966, 28036, 28105, 28174, 28242, 28310,
+    28377
+};
+
+static uint16_t vectorAngle = 0;
+static uint16_t vectorMagnitude = 0;
+static int16_t angleStep = 0;
+
+uint8_t PWM_svpwmNext[3];
+uint8_t PWM_svpwmDivider = 0;
+uint8_t PWM_svpwmCount = 0;
+bool PWM_svpwmOn = false;
+
+void PWM_svpwmCompute(uint16_t angle, uint16_t magnitude, uint8_t duty[3]){
+    if(magnitude > PWM_SVPWM_MAX)
+        magnitude = PWM_SVPWM_MAX;
+
+    // Six sectors of 60 degrees, and how far into the sector (0 - 255)
+    uint32_t scaled = (uint32_t)angle * 6;
+    uint8_t sector = (uint8_t)(scaled >> 16);
+    uint8_t index = (uint8_t)(scaled >> 8);
+
+    // Everything below is in OCR counts, Q8.8
+    uint16_t counts = ((uint32_t)magnitude * 255) >> 7;
+    uint16_t t1 = ((uint32_t)counts * pgm_read_word(&sinTable[256 - index])) >> 15;
+    uint16_t t2 = ((uint32_t)counts * pgm_read_word(&sinTable[index])) >> 15;
+
+    // Half of the zero vector goes on each end, so the pulses stay centered
+    uint16_t low = ((255U << 8) - t1 - t2) >> 1;
+    uint16_t high = low + t1 + t2;
+    uint16_t a, b, c;
+
+    switch(sector){
+        case 0:  a = high;      b = low + t2;   c = low;        break;
+        case 1:  a = low + t1;  b = high;       c = low;        break;
+        case 2:  a = low;       b = high;       c = low + t2;   break;
+        case 3:  a = low;       b = low + t1;   c = high;       break;
+        case 4:  a = low + t2;  b = low;        c = high;       break;
+        default: a = high;      b = low;        c = low + t1;   break;
+    }
+
+    duty[0] = (a + 128) >> 8;
+    duty[1] = (b + 128) >> 8;
+    duty[2] = (c + 128) >> 8;
+}
+
+void PWM_svpwmRun(void){
+    // Already inside an ISR, so nothing here can change while it's read
+    vectorAngle += angleStep;
+    PWM_svpwmCompute(vectorAngle, vectorMagnitude, PWM_svpwmNext);
+}
+
+void PWM_svpwmSet(uint16_t angle, uint16_t magnitude){
+    uint8_t oldSREG = SREG;
+    cli();
+    vectorAngle = angle;
+    vectorMagnitude = magnitude;
+    SREG = oldSREG;
+}
+
+void PWM_svpwmSpeed(int16_t step){
+    uint8_t oldSREG = SREG;
+    cli();
+    angleStep = step;
+    SREG = oldSREG;
+}
+
+void PWM_svpwmBegin(uint8_t divider){
+    PWM_powerUpdate(_6, true);
+    PWM_powerUpdate(_9, true);
+    PWM_powerUpdate(_11, true);
+    pinMode(6, OUTPUT);
+    pinMode(9, OUTPUT);
+    pinMode(11, OUTPUT);
+
+    uint8_t oldSREG = SREG;
+    cli();
+
+    // Hold the prescalers in reset and stop the timers while they're set up
+    GTCCR = _BV(TSM) | _BV(PSRASY) | _BV(PSRSYNC);
+    TIMSK0 &= ~(_BV(TOIE0)); // millis() would run 64 times too fast
+    ASSR &= ~(_BV(AS2));
+    TCCR0B = 0;
+    TCCR1B = 0;
+    TCCR2B = 0;
+
+    // 8-bit phase correct, non-inverted output on OCnA only
+    TCCR0A = _BV(COM0A1) | _BV(WGM00);
+    TCCR1A = _BV(COM1A1) | _BV(WGM10);
+    TCCR2A = _BV(COM2A1) | _BV(WGM20);
+
+    PWM_svpwmCompute(vectorAngle, vectorMagnitude, PWM_svpwmNext);
+    OCR1A = PWM_svpwmNext[0];
+    OCR2A = PWM_svpwmNext[1];
+    OCR0A = PWM_svpwmNext[2];
+
+    TCNT0 = 0;
+    TCNT1 = 0;
+    TCNT2 = 0;
+
+    // No prescaler on any of them, started one right after the other
+    TCCR0B = _BV(CS00);
+    TCCR1B = _BV(CS10);
+    TCCR2B = _BV(CS20);
+    GTCCR = 0;
+
+    // Both share the Timer1 overflow, and there isn't time for the
+    // control loop as well in a 512 cycle period
+    PWM_controlDivider = 0;
+
+    PWM_svpwmDivider = divider;
+    PWM_svpwmCount = 0;
+    PWM_svpwmOn = true;
+    if(divider)
+        TIMSK1 |= _BV(TOIE1);
+    SREG = oldSREG;
+}
+
+void PWM_svpwmStop(void){
+    uint8_t oldSREG = SREG;
+    cli();
+    PWM_svpwmDivider = 0;
+    PWM_svpwmOn = false;
+    if(!(PWM_sharedIrq & _BV(PWM_SHARED_TIMER1_OVF)))
+        TIMSK1 &= ~(_BV(TOIE1));
+
+    // Back to what the Arduino core set up: fast PWM on Timer0, 8-bit
+    // phase correct on Timers 1 and 2, all at clk/64, and millis()
+    TCCR0A = _BV(WGM01) | _BV(WGM00);
+    TCCR0B = _BV(CS01) | _BV(CS00);
+    TCCR1A = _BV(WGM10);
+    TCCR1B = _BV(CS11) | _BV(CS10);
+    TCCR2A = _BV(WGM20);
+    TCCR2B = _BV(CS22);
+    TIMSK0 |= _BV(TOIE0);
+    SREG = oldSREG;
+
+    // The timers are left on, analogWrite() can't turn them back on
+    digitalWrite(6, LOW);
+    digitalWrite(9, LOW);
+    digitalWrite(11, LOW);
+}
+
+#endif /*BOARD*/
@@ -7,8 +7,11 @@
 
 #include <Arduino.h>
 #include "PWM.h"
+#include "PWM_power.h"
 
 void setMode(PWM_PIN pin, PWM_MODE mode){
+    PWM_powerOn(pin); // A shut down timer ignores writes
+
     // Here we need to set the Waveform Generation Mode bits(WGM).
     // These control the overall mode of the timer and are split
     // between TCCnA and TCCnB
@@ -100,10 +103,19 @@ void setMode(PWM_PIN pin, PWM_MODE mode){
             } // end timer1
             break;
     } // end pin
+    PWM_powerUpdate(pin, false); // Shut down again if nothing uses it
+
+    PWM_SIG *sig = PWM_getSignal(pin);
+    if(sig)
+        sig->mode = mode;
+    sig = PWM_getSiblingSignal(pin);
+    if(sig)
+        sig->mode = mode;
 }
 
 void setAdvancedMode(PWM_PIN pin, PWM_MODE mode, PWM_ADV_MODE setting) {
     setMode(pin, mode); // Most of the work is already done in the normal function
+    PWM_powerOn(pin);
     switch(pin){
     case _3:
     case _11:
@@ -186,9 +198,18 @@ void setAdvancedMode(PWM_PIN pin, PWM_MODE mode, PWM_ADV_MODE setting) {
         } // end timer1
         break;
     } // end pin
+    PWM_powerUpdate(pin, false); // Shut down again if nothing uses it
+
+    PWM_SIG *sig = PWM_getSignal(pin);
+    if(sig)
+        sig->advMode = setting;
+    sig = PWM_getSiblingSignal(pin);
+    if(sig)
+        sig->advMode = setting;
 }
 
 void setOutputType(PWM_PIN pin, PWM_OUTPUT type){
+    PWM_powerOn(pin);
     switch(pin)
     {
         case _3:
@@ -254,6 +275,12 @@ void setOutputType(PWM_PIN pin, PWM_OUTPUT type){
             } // end type
             break;
     }
+    // Shuts the timer down if this was its last enabled output
+    PWM_powerUpdate(pin, type != PWM_DISABLE);
+
+    PWM_SIG *sig = PWM_getSignal(pin);
+    if(sig)
+        sig->output = type;
 }
 
 #endif /*BOARD*/
\ No newline at end of file
@@ -0,0 +1,41 @@
+/**
+ * Host stand-in for the parts of the Arduino core the library uses.
+ * Pin functions do nothing, millis() reads the PC's clock and Stream
+ * is an interface a host program can back with a file descriptor or a
+ * buffer.
+ */
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+
+#define INPUT           0
+#define OUTPUT          1
+#define INPUT_PULLUP    2
+#define LOW             0
+#define HIGH            1
+
+static inline void pinMode(uint8_t pin, uint8_t mode){ (void)pin; (void)mode; }
+static inline void digitalWrite(uint8_t pin, uint8_t value){ (void)pin; (void)value; }
+
+// Milliseconds from the PC's monotonic clock
+static inline unsigned long millis(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long)(now.tv_sec * 1000UL + now.tv_nsec / 1000000L);
+}
+
+class Stream {
+public:
+    virtual ~Stream(){}
+    virtual int available(void) = 0;
+    virtual int read(void) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size) = 0;
+};
+
+#endif /*HOST_ARDUINO_H*/
@@ -0,0 +1,47 @@
+/**
+ * Host stand-in for <avr/interrupt.h>. An ISR is an ordinary function
+ * that a host program can call to act like the interrupt happened.
+ *
+ * Nothing here is a vector table, so the host programs can't catch an
+ * ISR that wouldn't be linked on the board. On AVR the startup code
+ * puts a weak __bad_interrupt in every vector, and a weak ISR in the
+ * library loses to it.
+ */
+#ifndef HOST_AVR_INTERRUPT_H
+#define HOST_AVR_INTERRUPT_H
+
+#define ISR(vector, ...) \
+    extern "C" void vector(void) __VA_ARGS__; \
+    extern "C" void vector(void)
+
+#define sei()
+#define cli()
+
+#define TIMER0_COMPA_vect   host_TIMER0_COMPA_vect
+#define TIMER0_COMPB_vect   host_TIMER0_COMPB_vect
+#define TIMER1_CAPT_vect    host_TIMER1_CAPT_vect
+#define TIMER1_COMPA_vect   host_TIMER1_COMPA_vect
+#define TIMER1_COMPB_vect   host_TIMER1_COMPB_vect
+#define TIMER1_OVF_vect     host_TIMER1_OVF_vect
+#define TIMER2_COMPA_vect   host_TIMER2_COMPA_vect
+#define TIMER2_COMPB_vect   host_TIMER2_COMPB_vect
+#define TIMER2_OVF_vect     host_TIMER2_OVF_vect
+#define PCINT0_vect         host_PCINT0_vect
+#define PCINT1_vect         host_PCINT1_vect
+#define PCINT2_vect         host_PCINT2_vect
+
+// Declared here so a host program can call them
+extern "C" void host_TIMER0_COMPA_vect(void);
+extern "C" void host_TIMER0_COMPB_vect(void);
+extern "C" void host_TIMER1_CAPT_vect(void);
+extern "C" void host_TIMER1_COMPA_vect(void);
+extern "C" void host_TIMER1_COMPB_vect(void);
+extern "C" void host_TIMER1_OVF_vect(void);
+extern "C" void host_TIMER2_COMPA_vect(void);
+extern "C" void host_TIMER2_COMPB_vect(void);
+extern "C" void host_TIMER2_OVF_vect(void);
+extern "C" void host_PCINT0_vect(void);
+extern "C" void host_PCINT1_vect(void);
+extern "C" void host_PCINT2_vect(void);
+
+#endif /*HOST_AVR_INTERRUPT_H*/
@@ -0,0 +1,14 @@
+/** Host stand-in for <avr/sleep.h>, sleeping does nothing. */
+#ifndef HOST_AVR_SLEEP_H
+#define HOST_AVR_SLEEP_H
+
+#define SLEEP_MODE_IDLE     0
+#define SLEEP_MODE_PWR_DOWN 4
+#define SLEEP_MODE_PWR_SAVE 6
+
+static inline void set_sleep_mode(int mode){ (void)mode; }
+static inline void sleep_enable(void){}
+static inline void sleep_disable(void){}
+static inline void sleep_cpu(void){}
+
+#endif /*HOST_AVR_SLEEP_H*/
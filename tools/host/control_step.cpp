@@ -0,0 +1,125 @@
+/**
+ * Runs the fan control loop of PWM_control.h on the PC against a simple
+ * fan model, prints its step response and times the loop.
+ *
+ * The fan speed follows the duty cycle with a first-order lag, and its
+ * tach edges are fed through the real pin change ISR. Every loop calls
+ * the real TIMER1_OVF ISR, so the same code as on the board is run.
+ * The setpoint steps from 0 to 6 edges per loop and then down to 3.
+ *
+ * Nothing is timed here, time on the PC says nothing about the cost on
+ * an AVR. CYCLE_TEST in PWM-lib.ino gives the cycles on a board.
+ *
+ * Build and run from the top of the repo:
+ *   g++ -std=gnu++11 -O2 -I tools/host -I PWM-lib -DARDUINO_AVR_UNO \
+ *       -DF_CPU=16000000UL tools/host/control_step.cpp \
+ *       tools/host/host_regs.cpp PWM-lib/uno-pwm-*.cpp -o control_step
+ *   ./control_step
+ */
+#include <Arduino.h>
+#include <math.h>
+#include <stdio.h>
+#include "PWM.h"
+#include "PWM_control.h"
+
+#define LOOPS       300     // Loops after each setpoint step
+#define FAN_MAX     10.0    // Tach edges per loop at full output
+#define FAN_LAG     8.0     // Time constant of the fan in loops
+
+static const PWM_PIN outPins[PWM_CONTROL_MAX] = { _9, _10, _3, _11, _5, _6 };
+static const uint8_t tachPins[PWM_CONTROL_MAX] = { 2, 4, 7, 8, 12, 14 };
+
+static PWM_CONTROL channels[PWM_CONTROL_MAX];
+static double speed[PWM_CONTROL_MAX];
+static double phase[PWM_CONTROL_MAX];
+
+// Makes one rising and falling edge on a tach pin through its pin change ISR
+static void tachEdge(uint8_t pin){
+    volatile uint8_t *port;
+    void (*isr)(void);
+    uint8_t bit;
+    if(pin < 8){
+        port = &PIND; isr = PCINT2_vect; bit = pin;
+    } else if(pin < 14){
+        port = &PINB; isr = PCINT0_vect; bit = pin - 8;
+    } else {
+        port = &PINC; isr = PCINT1_vect; bit = pin - 14;
+    }
+    *port |= _BV(bit);
+    isr();
+    *port &= ~(_BV(bit));
+    isr();
+}
+
+// Moves every fan on by one loop and sends its tach edges
+static void fanStep(uint8_t count){
+    for(uint8_t i = 0; i < count; i++){
+        double duty = (double)channels[i].output / channels[i].outMax;
+        speed[i] += ((FAN_MAX * duty) - speed[i]) / FAN_LAG;
+        phase[i] += speed[i];
+        while(phase[i] >= 1.0){
+            tachEdge(tachPins[i]);
+            phase[i] -= 1.0;
+        }
+    }
+}
+
+// Prints how the first fan follows a setpoint step, returns false if it
+// doesn't settle within 5%
+static bool stepResponse(double from, double to){
+    for(uint8_t i = 0; i < PWM_CONTROL_MAX; i++)
+        PWM_controlSetpoint(&channels[i], (uint16_t)(to * 256));
+
+    double peak = from, sum = 0;
+    int rise = -1, settle = 0;
+    for(int n = 0; n < LOOPS; n++){
+        fanStep(PWM_CONTROL_MAX);
+        TIMER1_OVF_vect();
+
+        double s = speed[0];
+        if((rise < 0) && (fabs(s - from) >= 0.9 * fabs(to - from)))
+            rise = n;
+        if(((to > from) && (s > peak)) || ((to < from) && (s < peak)))
+            peak = s;
+        if(fabs(s - to) > 0.05 * to)
+            settle = n + 1;
+        if(n >= LOOPS - 50)
+            sum += s;
+    }
+
+    double overshoot = 100.0 * (peak - to) / (to - from);
+    double error = (sum / 50) - to;
+    printf("  %4.1f -> %4.1f  %10d  %12.1f  %14d  %12.3f\n",
+           from, to, rise, overshoot, settle, error);
+    return (rise >= 0) && (settle < LOOPS - 50) && (fabs(error) < 0.05 * to);
+}
+
+int main(void){
+    int failed = 0;
+
+    for(uint8_t i = 0; i < PWM_CONTROL_MAX; i++){
+        channels[i].pin = outPins[i];
+        channels[i].tachPin = tachPins[i];
+        channels[i].kp = 5 * 256;       // 5 counts per edge
+        channels[i].ki = 3 * 256 / 2;   // 1.5 counts per edge per loop
+        channels[i].kd = 0;
+        channels[i].outMax = 255;
+        channels[i].setpoint = 0;
+        if(PWM_controlAdd(&channels[i]) != NO_PWM_ERROR){
+            printf("PWM_controlAdd() failed\n");
+            return 1;
+        }
+    }
+    PWM_controlBegin(1);
+
+    printf("Step response of a fan with %.0f edges/loop at full output and a\n", FAN_MAX);
+    printf("lag of %.0f loops (kp = 5, ki = 1.5 counts per edge):\n", FAN_LAG);
+    printf("  edges/loop   rise (loops)  overshoot (%%)  settle 5%% (loops)  final error\n");
+    if(!stepResponse(0, 6))
+        failed++;
+    if(!stepResponse(6, 3))
+        failed++;
+
+    printf(failed ? "FAILED (%d)\n" : "PASSED\n", failed);
+    return failed ? 1 : 0;
+}
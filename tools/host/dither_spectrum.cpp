@@ -0,0 +1,108 @@
+/**
+ * Runs the dither interrupt of PWM_dither.h on the PC and looks at the
+ * spectrum of the duty cycle it makes.
+ *
+ * For every test value pin 11 is dithered for 4096 periods by calling
+ * the real TIMER2_OVF ISR, and OCR2A is recorded after each one. The
+ * average has to match the 16-bit value exactly, and a DFT of the
+ * sequence gives the lowest tone the dithering adds and how big it is.
+ *
+ * Build and run from the top of the repo:
+ *   g++ -std=gnu++11 -O2 -I tools/host -I PWM-lib -DARDUINO_AVR_UNO \
+ *       -DF_CPU=16000000UL tools/host/dither_spectrum.cpp \
+ *       tools/host/host_regs.cpp PWM-lib/uno-pwm-*.cpp -o dither_spectrum
+ *   ./dither_spectrum
+ */
+#include <Arduino.h>
+#include <math.h>
+#include <stdio.h>
+#include "PWM.h"
+#include "PWM_dither.h"
+
+#define PERIODS     4096
+#define PWM_HZ      31372.55    // Timer2 phase correct, no prescaler
+
+static double duty[PERIODS];
+
+int main(void){
+    static const uint16_t values[] = { 0x8001, 0x8010, 0x8040, 0x8080, 0x80C8, 0x80FF, 0x0001, 0xFE80 };
+    int failed = 0;
+
+    // Phase correct PWM on Timer2 (WGM 1), like the Arduino core sets it
+    TCCR2A = _BV(WGM20);
+    TCCR2B = _BV(CS20);
+
+    printf("  value  mean error  lowest tone (Hz)  tone size (counts)  rms (counts)\n");
+    for(unsigned v = 0; v < sizeof(values) / sizeof(values[0]); v++){
+        uint16_t value = values[v];
+        stopDither(_11);
+        if(setDitheredDuty(_11, value) != NO_PWM_ERROR){
+            printf(" 0x%04X  setDitheredDuty() failed\n", value);
+            failed++;
+            continue;
+        }
+
+        double sum = 0;
+        for(int n = 0; n < PERIODS; n++){
+            TIMER2_OVF_vect();
+            duty[n] = OCR2A;
+            sum += duty[n];
+        }
+
+        // A whole number of 256 periods has to average out exactly
+        double expected = (value >> 8) == 0xFF ? 255.0 : value / 256.0;
+        double mean = sum / PERIODS;
+        double meanError = mean - expected;
+
+        // Tones are at multiples of PWM_HZ / PERIODS, look for the lowest
+        // one that stands out and the biggest one overall
+        double lowest = 0, biggest = 0, power = 0;
+        for(int k = 1; k <= PERIODS / 2; k++){
+            double re = 0, im = 0;
+            for(int n = 0; n < PERIODS; n++){
+                double phase = 2.0 * M_PI * k * n / PERIODS;
+                re += (duty[n] - mean) * cos(phase);
+                im -= (duty[n] - mean) * sin(phase);
+            }
+            double size = 2.0 * sqrt(re * re + im * im) / PERIODS;
+            if(k == PERIODS / 2)
+                size /= 2.0;
+            power += size * size / 2.0;
+            if((lowest == 0) && (size > 1e-6))
+                lowest = PWM_HZ * k / PERIODS;
+            if(size > biggest)
+                biggest = size;
+        }
+
+        printf(" 0x%04X  %10.6f  %16.1f  %18.4f  %12.4f\n",
+               value, meanError, lowest, biggest, sqrt(power));
+
+        if((fabs(meanError) > 1e-9) || (biggest > 1.0) ||
+           ((lowest != 0) && (lowest < (PWM_HZ / 256.0) - 1e-6)))
+            failed++;
+    }
+
+    // With OCR2A as TOP, pin 11 can't be dithered but pin 3 still can
+    stopDither(_11);
+    TCCR2A = _BV(WGM21) | _BV(WGM20);
+    TCCR2B = _BV(WGM22) | _BV(CS20);
+    if((setDitheredDuty(_11, 0x8040) != UNDEFINED_PWM_VALUE) ||
+       (setDitheredDuty(_3, 0x8040) != NO_PWM_ERROR)){
+        printf("OCR2A as TOP wasn't handled\n");
+        failed++;
+    }
+    stopDither(_3);
+
+    // A shut down Timer2 is turned back on before its mode is read
+    TCCR2A = _BV(WGM20);
+    TCCR2B = _BV(CS20);
+    PRR |= _BV(PRTIM2);
+    if((setDitheredDuty(_3, 0x8040) != NO_PWM_ERROR) || (PRR & _BV(PRTIM2))){
+        printf("Timer2 wasn't turned on before dithering\n");
+        failed++;
+    }
+    stopDither(_3);
+
+    printf(failed ? "FAILED (%d)\n" : "PASSED\n", failed);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+"""
+Sends frames to PWM_serialPoll() running on the PC over a pseudo
+terminal and checks the acknowledgements and the registers after each.
+Then times a burst of full frames and reports frames and updates a
+second. A pseudo terminal has no baud rate, so that is what the decoder
+manages on the PC, not what a serial line to a board allows.
+
+Build tools/host/serial_pty.cpp first (see the top of that file), then
+run from the top of the repo:
+  python3 tools/host/serial_loopback.py ./serial_pty
+"""
+
+import os
+import select
+import subprocess
+import sys
+import threading
+import time
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+import pwm_frame  # noqa: E402
+
+# PWM_FREQUENCY, in the same order as PWM.h
+FREQ_31372_55 = 2
+FREQ_3921_16 = 4
+FREQ_976_56 = 6
+FREQ_490_2 = 7
+
+TIMEOUT_S = 1.0
+BURST_FRAMES = 2000
+
+
+def read_ack(master):
+    """Reads one 6 byte acknowledgement, None if it doesn't come."""
+    ack = b""
+    end = time.monotonic() + TIMEOUT_S
+    while len(ack) < 6:
+        left = end - time.monotonic()
+        if left <= 0 or not select.select([master], [], [], left)[0]:
+            return None
+        ack += os.read(master, 6 - len(ack))
+    return pwm_frame.decode_ack(ack)
+
+
+def read_state(proc):
+    """Reads the register line printed after an acknowledgement."""
+    if not select.select([proc.stdout], [], [], TIMEOUT_S)[0]:
+        return None
+    line = proc.stdout.readline().decode().split()
+    return dict(field.split("=") for field in line)
+
+
+def burst(binary):
+    """Times BURST_FRAMES full frames, gives (frames/s, updates/s, bad acks)."""
+    master, slave = os.openpty()
+    proc = subprocess.Popen([binary, os.ttyname(slave), "-q"], stdout=subprocess.PIPE)
+    os.close(slave)
+    try:
+        if read_state(proc) is None:
+            return None
+
+        # Acks are read while the frames are sent, so neither side fills
+        # up its buffer and stops
+        acks = bytearray()
+        done = threading.Event()
+
+        def reader():
+            while len(acks) < 6 * BURST_FRAMES:
+                if not select.select([master], [], [], TIMEOUT_S)[0]:
+                    break
+                acks.extend(os.read(master, 4096))
+            done.set()
+
+        pins = [3, 5, 6, 9, 10, 11]
+        frames = []
+        for n in range(BURST_FRAMES):
+            updates = [(pins[i % len(pins)], pwm_frame.FIELD_COMPARE, (n + i) & 0xFF)
+                       for i in range(pwm_frame.MAX_UPDATES)]
+            frames.append(pwm_frame.encode(n & 0xFF, updates))
+        data = b"".join(frames)
+
+        thread = threading.Thread(target=reader)
+        thread.start()
+        start = time.monotonic()
+        sent = 0
+        while sent < len(data):
+            sent += os.write(master, data[sent:sent + 4096])
+        done.wait(10 * TIMEOUT_S)
+        elapsed = time.monotonic() - start
+        thread.join()
+
+        bad = 0
+        count = min(len(acks) // 6, BURST_FRAMES)
+        for n in range(count):
+            if pwm_frame.decode_ack(bytes(acks[6 * n:6 * n + 6])) != (n & 0xFF, "NO_PWM_ERROR", 0xFF):
+                bad += 1
+        bad += BURST_FRAMES - count
+        return BURST_FRAMES / elapsed, BURST_FRAMES * pwm_frame.MAX_UPDATES / elapsed, bad
+    finally:
+        proc.kill()
+        proc.wait()
+        os.close(master)
+
+
+def check(name, ok, detail):
+    print("  %-40s %s%s" % (name, "ok" if ok else "FAILED ", "" if ok else detail))
+    return 0 if ok else 1
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("usage: %s <serial_pty binary>" % sys.argv[0])
+        return 2
+
+    master, slave = os.openpty()
+    proc = subprocess.Popen([sys.argv[1], os.ttyname(slave)], stdout=subprocess.PIPE)
+    os.close(slave)
+    failed = 0
+
+    def send(data):
+        os.write(master, data)
+
+    def exchange(data):
+        send(data)
+        return read_ack(master), read_state(proc)
+
+    try:
+        start = read_state(proc)
+        if start is None:
+            print("serial_pty didn't start")
+            return 1
+
+        # A good frame with two updates
+        frame = pwm_frame.encode(1, [(9, pwm_frame.FIELD_FREQUENCY, FREQ_3921_16),
+                                     (11, pwm_frame.FIELD_COMPARE, 64)])
+        ack, state = exchange(frame)
+        failed += check("good frame", ack == (1, "NO_PWM_ERROR", 0xFF) and
+                        state["TCCR1B"] == "2" and state["OCR2A"] == "64" and
+                        state["sig9.frequency"] == str(FREQ_3921_16), (ack, state))
+
+        # Bad CRC, nothing is applied
+        frame = bytearray(pwm_frame.encode(2, [(11, pwm_frame.FIELD_COMPARE, 10)]))
+        frame[-1] ^= 0xFF
+        ack, state = exchange(bytes(frame))
+        failed += check("bad CRC", ack == (2, "INVALID_PWM_FRAME", 0xFF) and
+                        state["OCR2A"] == "64", (ack, state))
+
+        # Bad LEN is acknowledged as soon as SEQ is in
+        send(bytes([pwm_frame.FRAME_SYNC, 5, 3]))
+        ack, state = read_ack(master), read_state(proc)
+        failed += check("bad LEN", ack == (3, "INVALID_PWM_FRAME", 0xFF), (ack, state))
+
+        # Pin 9 can't make 976.56 Hz, so the duty update before it isn't
+        # applied either and Timer1 keeps running
+        frame = pwm_frame.encode(4, [(11, pwm_frame.FIELD_COMPARE, 20),
+                                     (9, pwm_frame.FIELD_FREQUENCY, FREQ_976_56)])
+        ack, state = exchange(frame)
+        failed += check("frequency the pin can't make", ack == (4, "INVALID_PWM_FREQ", 1) and
+                        state["OCR2A"] == "64" and state["TCCR1B"] == "2" and
+                        state["sig9.frequency"] == str(FREQ_3921_16), (ack, state))
+
+        # A lost byte, then a pause, then a good frame. The two must not
+        # be joined.
+        lost = pwm_frame.encode(5, [(11, pwm_frame.FIELD_COMPARE, 30)])
+        send(lost[:4] + lost[5:])
+        time.sleep(0.2)
+        ack, state = read_ack(master), read_state(proc)
+        failed += check("lost byte dropped after a pause",
+                        ack == (5, "INVALID_PWM_FRAME", 0xFF) and state["OCR2A"] == "64",
+                        (ack, state))
+        frame = pwm_frame.encode(6, [(11, pwm_frame.FIELD_COMPARE, 40)])
+        ack, state = exchange(frame)
+        failed += check("next frame after the lost byte",
+                        ack == (6, "NO_PWM_ERROR", 0xFF) and state["OCR2A"] == "40",
+                        (ack, state))
+    finally:
+        proc.kill()
+        proc.wait()
+        os.close(master)
+
+    result = burst(sys.argv[1])
+    if result is None:
+        failed += check("burst of full frames", False, "serial_pty didn't start")
+    else:
+        frames, updates, bad = result
+        print("  %d frames of %d updates over the pseudo terminal:" % (BURST_FRAMES, pwm_frame.MAX_UPDATES))
+        print("    %.0f frames/s, %.0f updates/s" % (frames, updates))
+        failed += check("every frame in the burst acknowledged", bad == 0, "(%d bad)" % bad)
+
+    print("FAILED (%d)" % failed if failed else "PASSED")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,115 @@
+/**
+ * Runs PWM_serialPoll() on the PC with a pseudo terminal as the serial
+ * port, so the frame decoder can be tested with real bytes and pauses.
+ *
+ * Frames are read from and acknowledged on the terminal given as the
+ * first argument. After every acknowledgement one line with the timer
+ * registers and the PWM_SIG of pins 9 and 11 is printed on stdout,
+ * unless -q is given as the second argument (used to time a burst).
+ * tools/host/serial_loopback.py starts this and checks the results.
+ *
+ * Build from the top of the repo:
+ *   g++ -std=gnu++11 -O2 -I tools/host -I PWM-lib -DARDUINO_AVR_UNO \
+ *       -DF_CPU=16000000UL tools/host/serial_pty.cpp \
+ *       tools/host/host_regs.cpp PWM-lib/uno-pwm-*.cpp -o serial_pty
+ */
+#include <Arduino.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include "PWM.h"
+#include "PWM_serial.h"
+
+// Stream on a file descriptor, reads never block
+class FdStream : public Stream {
+public:
+    FdStream(int fd) : fd(fd), have(false), next(0) {}
+
+    int available(void){
+        if(!have){
+            ssize_t n = ::read(fd, &next, 1);
+            have = (n == 1);
+        }
+        return have ? 1 : 0;
+    }
+
+    int read(void){
+        if(!available())
+            return -1;
+        have = false;
+        return next;
+    }
+
+    size_t write(const uint8_t *buffer, size_t size){
+        ssize_t n = ::write(fd, buffer, size);
+        return (n < 0) ? 0 : (size_t)n;
+    }
+
+private:
+    int fd;
+    bool have;
+    uint8_t next;
+};
+
+static PWM_SIG sig9, sig11;
+
+static void printState(void){
+    printf("TCCR1B=%u OCR1A=%u TCCR2B=%u OCR2A=%u OCR0B=%u "
+           "sig9.frequency=%u sig9.dutyCycle=%u sig11.frequency=%u sig11.dutyCycle=%u\n",
+           TCCR1B, OCR1A, TCCR2B, OCR2A, OCR0B,
+           sig9.frequency, sig9.dutyCycle, sig11.frequency, sig11.dutyCycle);
+    fflush(stdout);
+}
+
+int main(int argc, char **argv){
+    if(argc < 2){
+        fprintf(stderr, "usage: %s <terminal> [-q]\n", argv[0]);
+        return 2;
+    }
+    int fd = open(argv[1], O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if(fd < 0){
+        perror(argv[1]);
+        return 2;
+    }
+    struct termios tio;
+    tcgetattr(fd, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(fd, TCSANOW, &tio);
+
+    // The Arduino core's setup: phase correct at clk/64 on Timers 1
+    // and 2, fast PWM at clk/64 on Timer0
+    TCCR0A = _BV(WGM01) | _BV(WGM00);
+    TCCR0B = _BV(CS01) | _BV(CS00);
+    TCCR1A = _BV(WGM10);
+    TCCR1B = _BV(CS11) | _BV(CS10);
+    TCCR2A = _BV(WGM20);
+    TCCR2B = _BV(CS22);
+
+    sig9.pin = _9;
+    sig9.frequency = _490_2Hz;
+    sig9.dutyCycle = 0;
+    sig11.pin = _11;
+    sig11.frequency = _490_2Hz;
+    sig11.dutyCycle = 0;
+    PWM_init(&sig9);
+    PWM_init(&sig11);
+
+    bool quiet = (argc > 2) && (strcmp(argv[2], "-q") == 0);
+    FdStream port(fd);
+    printState();
+    for(;;){
+        if(PWM_serialPoll(port)){
+            if(!quiet)
+                printState();
+        } else {
+            // Wakes up as soon as a byte comes in, and every millisecond
+            // so the timeout between bytes is still checked
+            struct pollfd wait = { fd, POLLIN, 0 };
+            poll(&wait, 1, 1);
+        }
+    }
+}
@@ -0,0 +1,101 @@
+/**
+ * Checks the duty cycles of PWM_svpwm.h on the PC.
+ *
+ * For every angle and a few magnitudes, the line to line voltages made
+ * by PWM_svpwmCompute() are compared with the ideal ones and the pulses
+ * are checked to be centered in the period. It also checks that
+ * PWM_svpwmStop() gives the timers back the way the Arduino core set
+ * them up (and powered), and that the control loop can't run at the
+ * same time.
+ *
+ * Build and run from the top of the repo:
+ *   g++ -std=gnu++11 -O2 -I tools/host -I PWM-lib -DARDUINO_AVR_UNO \
+ *       -DF_CPU=16000000UL tools/host/svpwm_check.cpp \
+ *       tools/host/host_regs.cpp PWM-lib/uno-pwm-*.cpp -o svpwm_check
+ *   ./svpwm_check
+ */
+#include <Arduino.h>
+#include <math.h>
+#include <stdio.h>
+#include "PWM.h"
+#include "PWM_svpwm.h"
+#include "PWM_control.h"
+
+#define LINE_TOLERANCE      2.0     // Counts
+#define CENTER_TOLERANCE    1       // Counts
+
+int main(void){
+    static const uint16_t magnitudes[] = { PWM_SVPWM_MAX, 24576, 16384, 8192, 0 };
+    int failed = 0;
+
+    printf("  magnitude  worst line error (counts)  worst center error (counts)\n");
+    for(unsigned m = 0; m < sizeof(magnitudes) / sizeof(magnitudes[0]); m++){
+        double k = magnitudes[m] / 32768.0;
+        double worstLine = 0;
+        int worstCenter = 0;
+
+        for(uint32_t angle = 0; angle < 65536; angle++){
+            uint8_t duty[3];
+            PWM_svpwmCompute((uint16_t)angle, magnitudes[m], duty);
+
+            // Phase A leads B by 120 degrees and B leads C, so the line
+            // voltages are 30 degrees ahead of the phase voltages
+            double theta = 2.0 * M_PI * angle / 65536.0;
+            double ab = k * 255.0 * cos(theta + M_PI / 6.0);
+            double bc = k * 255.0 * cos(theta - M_PI / 2.0);
+            double errAB = fabs((duty[0] - duty[1]) - ab);
+            double errBC = fabs((duty[1] - duty[2]) - bc);
+            if(errAB > worstLine)
+                worstLine = errAB;
+            if(errBC > worstLine)
+                worstLine = errBC;
+
+            // The zero vector is split evenly, so the highest and lowest
+            // duty cycles are the same distance from the ends
+            uint8_t high = duty[0], low = duty[0];
+            for(uint8_t i = 1; i < 3; i++){
+                if(duty[i] > high) high = duty[i];
+                if(duty[i] < low)  low = duty[i];
+            }
+            int center = abs((int)high + (int)low - 255);
+            if(center > worstCenter)
+                worstCenter = center;
+        }
+
+        printf("  %9u  %25.2f  %27d\n", magnitudes[m], worstLine, worstCenter);
+        if((worstLine > LINE_TOLERANCE) || (worstCenter > CENTER_TOLERANCE))
+            failed++;
+    }
+
+    // The control loop is stopped and can't be started while it runs.
+    // Timers 1 and 2 start out shut down, like after setOutputType()
+    // turned their last outputs off.
+    PRR = _BV(PRTIM1) | _BV(PRTIM2);
+    PWM_controlBegin(4);
+    PWM_svpwmBegin(3);
+    if(PWM_controlDivider || (PWM_controlBegin(4) != UNDEFINED_PWM_VALUE)){
+        printf("The control loop ran with the space vector PWM\n");
+        failed++;
+    }
+
+    // Timers 1 and 2 go back to 8-bit phase correct at clk/64
+    PWM_svpwmStop();
+    if((TCCR0A != (_BV(WGM01) | _BV(WGM00))) || (TCCR0B != (_BV(CS01) | _BV(CS00))) ||
+       (TCCR1A != _BV(WGM10)) || (TCCR1B != (_BV(CS11) | _BV(CS10))) ||
+       (TCCR2A != _BV(WGM20)) || (TCCR2B != _BV(CS22)) || !(TIMSK0 & _BV(TOIE0))){
+        printf("PWM_svpwmStop() didn't give the timers back\n");
+        failed++;
+    }
+    if(PRR & (_BV(PRTIM0) | _BV(PRTIM1) | _BV(PRTIM2))){
+        printf("PWM_svpwmStop() left timers shut down, PRR = 0x%02X\n", PRR);
+        failed++;
+    }
+    if(PWM_controlBegin(4) != NO_PWM_ERROR){
+        printf("The control loop couldn't start after PWM_svpwmStop()\n");
+        failed++;
+    }
+    PWM_controlBegin(0);
+
+    printf(failed ? "FAILED (%d)\n" : "PASSED\n", failed);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""
+Reference encoder for the binary frames read by PWM_serialPoll().
+
+See PWM-lib/PWM_serial.h for the layout of a frame and its
+acknowledgement. Only the standard library is used, so this can be
+copied into any host program.
+"""
+
+import struct
+
+FRAME_SYNC = 0xA5
+ACK_SYNC = 0x5A
+MAX_UPDATES = 16
+
+# PWM_FIELD
+FIELD_FREQUENCY = 0
+FIELD_MODE = 1
+FIELD_ADV_MODE = 2
+FIELD_OUTPUT = 3
+FIELD_DUTY = 4
+FIELD_COMPARE = 5
+
+# PWM_LOG, in the same order as PWM.h
+PWM_LOG = [
+    "NO_PWM_ERROR",
+    "UNDEFINED_PWM_VALUE",
+    "INVALID_PWM_FREQ",
+    "INVALID_PWM_PIN",
+    "INVALID_PWM_DUTY_CYCLE_VALUE",
+    "PWM_MEASURE_TIMEOUT",
+    "PWM_MEASURE_OVERRUN",
+    "INVALID_PWM_PULSE_WIDTH",
+    "PWM_PULSE_BUSY",
+    "INVALID_PWM_FRAME",
+]
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, the same as PWM_crc16()."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def encode(seq, updates):
+    """
+    Builds a frame from a list of (pin, field, value) updates.
+
+    For FIELD_ADV_MODE the value is (mode << 8) | advMode.
+    """
+    if not 1 <= len(updates) <= MAX_UPDATES:
+        raise ValueError("a frame holds 1 to %d updates" % MAX_UPDATES)
+    body = bytes([len(updates) * 4, seq & 0xFF])
+    for pin, field, value in updates:
+        body += struct.pack("<BBH", pin, field, value)
+    return bytes([FRAME_SYNC]) + body + struct.pack("<H", crc16(body))
+
+
+def decode_ack(ack):
+    """Gives (seq, PWM_LOG name, index) from a 6 byte acknowledgement."""
+    if len(ack) != 6 or ack[0] != ACK_SYNC:
+        raise ValueError("not an acknowledgement")
+    if struct.unpack("<H", ack[4:6])[0] != crc16(ack[1:4]):
+        raise ValueError("bad CRC")
+    seq, status, index = ack[1], ack[2], ack[3]
+    name = PWM_LOG[status] if status < len(PWM_LOG) else "UNKNOWN(%d)" % status
+    return seq, name, index
+
+
+if __name__ == "__main__":
+    # Pin 9 to 50% and pin 11 to an OCR of 64 in one frame
+    frame = encode(1, [(9, FIELD_DUTY, 50), (11, FIELD_COMPARE, 64)])
+    print(frame.hex(" "))